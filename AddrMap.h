@@ -0,0 +1,181 @@
+//  AddrMap.h
+//  Maps the addresses of shared variables to transaction object ids
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+
+#ifndef ADDRMAP_H
+#define ADDRMAP_H
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <cstdint>
+
+/*
+ * Most regions an AddrMap holds; a benchmark registers a handful of arrays.
+ * */
+#define ADDRMAP_MAX_REGIONS 64
+
+/*
+ * Initial number of slots of the table of scattered addresses, a power of two.
+ * */
+#ifndef ADDRMAP_INITIAL_SLOTS
+#define ADDRMAP_INITIAL_SLOTS 1024
+#endif
+
+/*
+ * A contiguous array of 'count' variables 'stride' bytes apart, the i-th
+ * variable being tobj firstId + i.
+ * */
+class AddrRegion
+{
+	//public members of the class
+	public:
+	uintptr_t base;
+	uintptr_t bytes;
+	long int stride;
+	long int firstId;
+};
+
+/*
+ * Open addressing table of scattered addresses. Slot i is free while key[i]
+ * is 0, so NULL cannot be registered; the id of a slot is stored before its
+ * key is published.
+ * */
+class AddrTable
+{
+	//public members of the class
+	public:
+	long int slots;
+	long int used;
+	std::atomic<uintptr_t> *keys;
+	long int *ids;
+
+	AddrTable(long int slots)
+	{
+		this->slots = slots;
+		used = 0;
+		keys = new std::atomic<uintptr_t>[slots];
+		ids = new long int[slots];
+		for(long int i = 0;i<slots;i++) {
+			keys[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	//first slot to probe for 'addr', by fibonacci hashing of the word address
+	long int home(uintptr_t addr)
+	{
+		return (long int)(((addr >> 3) * 0x9e3779b97f4a7c15ULL) >> 20) & (slots - 1);
+	}
+};
+
+/*
+ * Address to tobj id map of a benchmark. Arrays are registered as regions, so
+ * finding the id of one of their elements is a subtraction and a division;
+ * other addresses go to a hash table. Lookups take no lock and may run
+ * alongside registrations, which are serialized by a mutex. Tables replaced
+ * on growth are kept, as a lookup may still be probing them.
+ * */
+class AddrMap
+{
+	//public members of the class
+	public:
+	AddrMap()
+	{
+		numRegions.store(0);
+		table.store(new AddrTable(ADDRMAP_INITIAL_SLOTS));
+	}
+
+	/*
+	 * Registers 'count' variables starting at 'base', 'stride' bytes apart,
+	 * as tobjs firstId, firstId + 1, ...
+	 * */
+	void addRegion(const void *base, long int count, long int stride, long int firstId)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		int n = numRegions.load(std::memory_order_relaxed);
+		if(n == ADDRMAP_MAX_REGIONS) {
+			throw std::length_error("AddrMap: too many regions");
+		}
+		regions[n].base = (uintptr_t)base;
+		regions[n].bytes = (uintptr_t)(count * stride);
+		regions[n].stride = stride;
+		regions[n].firstId = firstId;
+		numRegions.store(n + 1, std::memory_order_release);
+	}
+
+	/*
+	 * Registers the single variable at 'addr' as tobj 'id'. Like map::insert
+	 * it keeps the id of an address that is already registered.
+	 * */
+	void insert(const void *addr, long int id)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		AddrTable *current = table.load(std::memory_order_relaxed);
+		//kept at most half full, so that probes stay short
+		if(2 * (current->used + 1) > current->slots) {
+			AddrTable *grown = new AddrTable(2 * current->slots);
+			for(long int i = 0;i<current->slots;i++) {
+				uintptr_t key = current->keys[i].load(std::memory_order_relaxed);
+				if(key != 0) {
+					place(grown, key, current->ids[i]);
+				}
+			}
+			table.store(grown, std::memory_order_release);
+			current = grown;
+		}
+		place(current, (uintptr_t)addr, id);
+	}
+
+	/*
+	 * Returns the tobj id of the variable at 'addr'. Throws out_of_range if
+	 * it was never registered, like map::at.
+	 * */
+	long int at(const void *addr)
+	{
+		uintptr_t key = (uintptr_t)addr;
+		int n = numRegions.load(std::memory_order_acquire);
+		for(int i = 0;i<n;i++) {
+			uintptr_t offset = key - regions[i].base;
+			if(offset < regions[i].bytes) {
+				return regions[i].firstId + offset / regions[i].stride;
+			}
+		}
+		AddrTable *current = table.load(std::memory_order_acquire);
+		for(long int i = current->home(key);;i = (i + 1) & (current->slots - 1)) {
+			uintptr_t slotKey = current->keys[i].load(std::memory_order_acquire);
+			if(slotKey == key) {
+				return current->ids[i];
+			}
+			if(slotKey == 0) {
+				throw std::out_of_range("AddrMap: address not registered");
+			}
+		}
+	}
+
+	//private members of the class
+	private:
+	std::mutex lock;
+	AddrRegion regions[ADDRMAP_MAX_REGIONS];
+	std::atomic<int> numRegions;
+	std::atomic<AddrTable*> table;
+
+	//stores 'key' in 'target' unless it is already there
+	void place(AddrTable *target, uintptr_t key, long int id)
+	{
+		for(long int i = target->home(key);;i = (i + 1) & (target->slots - 1)) {
+			uintptr_t slotKey = target->keys[i].load(std::memory_order_relaxed);
+			if(slotKey == key) {
+				return;
+			}
+			if(slotKey == 0) {
+				target->ids[i] = id;
+				target->keys[i].store(key, std::memory_order_release);
+				target->used++;
+				return;
+			}
+		}
+	}
+};
+
+#endif /* ADDRMAP_H */
@@ -0,0 +1,329 @@
+//  Affinity.h
+//  Thread pinning and NUMA placement for the STMs and their benchmarks
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+
+#ifndef AFFINITY_H
+#define AFFINITY_H
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+/*
+ * Thread placement policies:
+ * AFFINITY_NONE    - threads are left to the scheduler
+ * AFFINITY_COMPACT - thread i on the i-th processor, filling a node before the next
+ *                    and the cores of a node before their hyperthread siblings
+ * AFFINITY_SCATTER - consecutive threads on different nodes, then different cores
+ * AFFINITY_NODE    - threads split in blocks over the nodes, each thread free to
+ *                    run on any processor of its node
+ * */
+enum AffinityPolicy{AFFINITY_NONE,AFFINITY_COMPACT,AFFINITY_SCATTER,AFFINITY_NODE};
+
+/*
+ * Placement of the memory allocated for the transaction objects:
+ * PLACE_FIRST_TOUCH - the kernel default, pages land on the node of the thread
+ *                     that first touches them, usually the main thread's
+ * PLACE_INTERLEAVE  - pages are spread round robin over all the nodes
+ * */
+enum PlacementPolicy{PLACE_FIRST_TOUCH,PLACE_INTERLEAVE};
+
+#define MPOL_DEFAULT_MODE 0
+#define MPOL_INTERLEAVE_MODE 3
+#define AFFINITY_MAX_NODES 1024
+
+/*
+ * Parses a sysfs list such as "0-3,8,10-11".
+ * */
+inline std::vector<int> affinityParseList(const std::string &list)
+{
+	std::vector<int> ids;
+	size_t pos = 0;
+	while(pos < list.size()) {
+		size_t end = list.find(',', pos);
+		if(end == std::string::npos) {
+			end = list.size();
+		}
+		std::string range = list.substr(pos, end - pos);
+		size_t dash = range.find('-');
+		if(!range.empty() && range[0] >= '0' && range[0] <= '9') {
+			int first = atoi(range.c_str());
+			int last = (dash == std::string::npos) ? first : atoi(range.c_str() + dash + 1);
+			for(int id = first;id<=last;id++) {
+				ids.push_back(id);
+			}
+		}
+		pos = end + 1;
+	}
+	return ids;
+}
+
+/*
+ * First line of a sysfs file, empty if it cannot be read.
+ * */
+inline std::string affinityReadLine(const std::string &path)
+{
+	std::ifstream file(path.c_str());
+	std::string line;
+	if(file) {
+		std::getline(file, line);
+	}
+	return line;
+}
+
+/*
+ * A processor and where it sits.
+ * */
+class CpuInfo
+{
+	//public members of the class
+	public:
+	int cpu;
+	int node;
+	int package;
+	int core;
+	//0 for the first hyperthread of a core, 1 for the second and so on
+	int sibling;
+};
+
+/*
+ * Processors and NUMA nodes of the machine, read from sysfs once. Without
+ * sysfs every online processor is taken to be on node 0.
+ * */
+class CpuTopology
+{
+	//public members of the class
+	public:
+	std::vector<CpuInfo> cpus;
+	std::vector<int> nodes;
+
+	CpuTopology()
+	{
+		std::vector<int> online = affinityParseList(affinityReadLine("/sys/devices/system/cpu/online"));
+		if(online.empty()) {
+			for(int i = 0;i<sysconf(_SC_NPROCESSORS_ONLN);i++) {
+				online.push_back(i);
+			}
+		}
+		nodes = affinityParseList(affinityReadLine("/sys/devices/system/node/has_cpu"));
+		std::vector<int> nodeOf(online.empty() ? 0 : online.back() + 1, 0);
+		for(size_t n = 0;n<nodes.size();n++) {
+			std::vector<int> ids = affinityParseList(affinityReadLine("/sys/devices/system/node/node" + std::to_string(nodes[n]) + "/cpulist"));
+			for(size_t i = 0;i<ids.size();i++) {
+				if(ids[i] < (int)nodeOf.size()) {
+					nodeOf[ids[i]] = nodes[n];
+				}
+			}
+		}
+		if(nodes.empty()) {
+			nodes.push_back(0);
+		}
+		for(size_t i = 0;i<online.size();i++) {
+			std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(online[i]) + "/topology/";
+			CpuInfo info;
+			info.cpu = online[i];
+			info.node = nodeOf[online[i]];
+			info.package = atoi(affinityReadLine(dir + "physical_package_id").c_str());
+			info.core = atoi(affinityReadLine(dir + "core_id").c_str());
+			info.sibling = 0;
+			for(size_t j = 0;j<cpus.size();j++) {
+				if(cpus[j].package == info.package && cpus[j].core == info.core) {
+					info.sibling++;
+				}
+			}
+			cpus.push_back(info);
+		}
+	}
+
+	//processors in the order a policy hands them out to threads
+	std::vector<CpuInfo> ordered(int policy)
+	{
+		//by node, and within a node every core before the second hyperthread of any
+		std::vector<CpuInfo> order = cpus;
+		std::sort(order.begin(), order.end(), [](const CpuInfo &a, const CpuInfo &b) {
+			if(a.node != b.node) return a.node < b.node;
+			if(a.sibling != b.sibling) return a.sibling < b.sibling;
+			if(a.package != b.package) return a.package < b.package;
+			return a.core < b.core;
+		});
+		if(policy == AFFINITY_SCATTER) {
+			//deal the processors of the nodes out in turn
+			std::vector<CpuInfo> scattered;
+			std::vector<size_t> next(nodes.size(), 0);
+			while(scattered.size() < order.size()) {
+				for(size_t n = 0;n<nodes.size();n++) {
+					size_t seen = 0;
+					for(size_t i = 0;i<order.size();i++) {
+						if(order[i].node == nodes[n] && seen++ == next[n]) {
+							scattered.push_back(order[i]);
+							next[n]++;
+							break;
+						}
+					}
+				}
+			}
+			return scattered;
+		}
+		return order;
+	}
+};
+
+/*
+ * Topology of the machine.
+ * */
+inline CpuTopology* cpuTopology()
+{
+	static CpuTopology topology;
+	return &topology;
+}
+
+/*
+ * Policy named by the STM_AFFINITY environment variable - compact, scatter or
+ * node - or 'policy' if it is not set.
+ * */
+inline int affinityFromEnv(int policy)
+{
+	const char *name = getenv("STM_AFFINITY");
+	if(name == NULL) {
+		return policy;
+	}
+	if(strcmp(name, "compact") == 0) return AFFINITY_COMPACT;
+	if(strcmp(name, "scatter") == 0) return AFFINITY_SCATTER;
+	if(strcmp(name, "node") == 0) return AFFINITY_NODE;
+	return AFFINITY_NONE;
+}
+
+/*
+ * Placement named by the STM_PLACEMENT environment variable - first-touch or
+ * interleave - or 'placement' if it is not set.
+ * */
+inline int placementFromEnv(int placement)
+{
+	const char *name = getenv("STM_PLACEMENT");
+	if(name == NULL) {
+		return placement;
+	}
+	return (strcmp(name, "interleave") == 0) ? PLACE_INTERLEAVE : PLACE_FIRST_TOUCH;
+}
+
+/*
+ * Pins the calling thread, thread 'threadId' of 'numThreads', as 'policy'
+ * says. Returns false if the policy is AFFINITY_NONE or pinning failed.
+ * */
+inline bool pinThread(int threadId, int numThreads, int policy)
+{
+	if(policy == AFFINITY_NONE) {
+		return false;
+	}
+	CpuTopology *topology = cpuTopology();
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if(policy == AFFINITY_NODE) {
+		int nodes = topology->nodes.size();
+		int node = topology->nodes[(long int)threadId * nodes / std::max(numThreads, 1) % nodes];
+		for(size_t i = 0;i<topology->cpus.size();i++) {
+			if(topology->cpus[i].node == node) {
+				CPU_SET(topology->cpus[i].cpu, &set);
+			}
+		}
+	} else {
+		std::vector<CpuInfo> order = topology->ordered(policy);
+		CPU_SET(order[threadId % order.size()].cpu, &set);
+	}
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+/*
+ * Sets the memory policy of the calling thread to 'placement' for as long as
+ * it lives, then restores the default first touch policy. Pages touched
+ * while it is in scope follow the placement.
+ * */
+class NumaPlacement
+{
+	//public members of the class
+	public:
+	NumaPlacement(int placement)
+	{
+		active = false;
+		if(placement != PLACE_INTERLEAVE) {
+			return;
+		}
+		unsigned long mask[AFFINITY_MAX_NODES / (8*sizeof(unsigned long))];
+		memset(mask, 0, sizeof(mask));
+		std::vector<int> nodes = affinityParseList(affinityReadLine("/sys/devices/system/node/has_memory"));
+		for(size_t i = 0;i<nodes.size();i++) {
+			if(nodes[i] < AFFINITY_MAX_NODES) {
+				mask[nodes[i] / (8*sizeof(unsigned long))] |= 1UL << (nodes[i] % (8*sizeof(unsigned long)));
+			}
+		}
+		if(nodes.size() > 1) {
+			active = (syscall(SYS_set_mempolicy, MPOL_INTERLEAVE_MODE, mask, AFFINITY_MAX_NODES) == 0);
+		}
+	}
+
+	~NumaPlacement()
+	{
+		if(active) {
+			syscall(SYS_set_mempolicy, MPOL_DEFAULT_MODE, NULL, 0);
+		}
+	}
+
+	//private members of the class
+	private:
+	bool active;
+};
+
+/*
+ * Local and remote page allocations of every node, from the kernel's
+ * numastat counters. These count the whole system, not only this process.
+ * */
+class NumaCounters
+{
+	//public members of the class
+	public:
+	long int local;
+	long int remote;
+
+	NumaCounters()
+	{
+		local = 0;
+		remote = 0;
+		std::vector<int> nodes = affinityParseList(affinityReadLine("/sys/devices/system/node/online"));
+		for(size_t n = 0;n<nodes.size();n++) {
+			std::ifstream file(("/sys/devices/system/node/node" + std::to_string(nodes[n]) + "/numastat").c_str());
+			std::string name;
+			long int value;
+			while(file >> name >> value) {
+				if(name == "local_node") {
+					local += value;
+				} else if(name == "other_node") {
+					remote += value;
+				}
+			}
+		}
+	}
+
+	//prints the allocations made since 'before', if the kernel exposes them
+	void report(const NumaCounters &before)
+	{
+		long int localDelta = local - before.local;
+		long int remoteDelta = remote - before.remote;
+		if(localDelta + remoteDelta <= 0) {
+			return;
+		}
+		std::cout<<"NUMA page allocations (system wide) local : "<<localDelta<<"  remote : "<<remoteDelta
+			<<"  remote share : "<<100.0 * remoteDelta / (localDelta + remoteDelta)<<"%"<<std::endl;
+	}
+};
+
+#endif /* AFFINITY_H */
@@ -0,0 +1,206 @@
+//  Harness.h
+//  Persistent thread pool that times the test applications of KSFTM, PKTO and SFTM
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+
+#ifndef HARNESS_H
+#define HARNESS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#include "Affinity.h"
+
+using namespace std;
+
+/*
+ * Phases of a measurement: transactions run during warmup and measure, and
+ * only the ones ending while measuring are counted.
+ * */
+enum HarnessPhase{PHASE_WARMUP,PHASE_MEASURE,PHASE_STOP};
+
+/*
+ * Barrier for a fixed number of threads. Threads sleep while waiting, as the
+ * pool usually has more threads than processors.
+ * */
+class HarnessBarrier
+{
+	//public members of the class
+	public:
+	HarnessBarrier(int count)
+	{
+		this->count = count;
+		waiting = 0;
+		generation = 0;
+	}
+
+	void wait()
+	{
+		unique_lock<mutex> guard(lock);
+		long int arrived = generation;
+		if(++waiting == count) {
+			waiting = 0;
+			generation++;
+			cond.notify_all();
+			return;
+		}
+		cond.wait(guard, [&]() { return generation != arrived; });
+	}
+
+	//private members of the class
+	private:
+	mutex lock;
+	condition_variable cond;
+	int count;
+	int waiting;
+	long int generation;
+};
+
+/*
+ * Counters of a thread, aligned to their own cache line so that threads
+ * counting their transactions do not falsely share.
+ * */
+class alignas(64) HarnessStats
+{
+	//public members of the class
+	public:
+	long int commits;
+	long int aborts;
+	//longest time a transaction took to commit, in seconds
+	double worstTime;
+	char pad[64 - 2*sizeof(long int) - sizeof(double)];
+};
+
+/*
+ * Outcome of one measurement.
+ * */
+class HarnessResult
+{
+	//public members of the class
+	public:
+	long int commits;
+	long int aborts;
+	double seconds;
+	double worstTime;
+};
+
+/*
+ * Pool of 'numThreads' threads created once. measure() releases them through
+ * the start barrier, lets them run transactions for a warmup and then for a
+ * fixed duration, and collects them at the stop barrier, so thread creation
+ * is never timed. 'body(id)' runs one transaction to commit on thread 'id'
+ * and returns the number of times it aborted. Each thread pins itself as the
+ * AffinityPolicy 'affinity' says before its first transaction.
+ * */
+class Harness
+{
+	//public members of the class
+	public:
+	Harness(int numThreads, function<int(int)> body, int affinity = AFFINITY_NONE) : startBarrier(numThreads + 1), stopBarrier(numThreads + 1)
+	{
+		this->body = body;
+		this->numThreads = numThreads;
+		this->affinity = affinity;
+		quit = false;
+		phase.store(PHASE_STOP);
+		//plain new does not honour alignas before C++17
+		void *memory = NULL;
+		if(posix_memalign(&memory, alignof(HarnessStats), numThreads * sizeof(HarnessStats)) != 0) {
+			throw bad_alloc();
+		}
+		stats = static_cast<HarnessStats*>(memory);
+		for(int i = 0;i<numThreads;i++) {
+			threads.push_back(thread(&Harness::worker, this, i));
+		}
+	}
+
+	HarnessResult measure(int warmupMs, int durationMs)
+	{
+		for(int i = 0;i<threads.size();i++) {
+			stats[i].commits = 0;
+			stats[i].aborts = 0;
+			stats[i].worstTime = 0.0;
+		}
+		phase.store(PHASE_WARMUP);
+		startBarrier.wait();
+		this_thread::sleep_for(chrono::milliseconds(warmupMs));
+
+		chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+		phase.store(PHASE_MEASURE);
+		this_thread::sleep_for(chrono::milliseconds(durationMs));
+		phase.store(PHASE_STOP);
+		chrono::steady_clock::time_point end = chrono::steady_clock::now();
+		stopBarrier.wait();
+
+		HarnessResult result;
+		result.commits = 0;
+		result.aborts = 0;
+		result.seconds = chrono::duration<double>(end - begin).count();
+		result.worstTime = 0.0;
+		for(int i = 0;i<threads.size();i++) {
+			result.commits += stats[i].commits;
+			result.aborts += stats[i].aborts;
+			result.worstTime = max(result.worstTime, stats[i].worstTime);
+		}
+		return result;
+	}
+
+	//true while the transactions that commit are being counted
+	bool measuring() const
+	{
+		return phase.load(memory_order_relaxed) == PHASE_MEASURE;
+	}
+
+	//ends the threads of the pool
+	~Harness()
+	{
+		quit = true;
+		startBarrier.wait();
+		for(int i = 0;i<threads.size();i++) {
+			threads[i].join();
+		}
+		free(stats);
+	}
+
+	//private members of the class
+	private:
+	function<int(int)> body;
+	int numThreads;
+	int affinity;
+	vector<thread> threads;
+	HarnessStats *stats;
+	HarnessBarrier startBarrier;
+	HarnessBarrier stopBarrier;
+	atomic<int> phase;
+	bool quit;
+
+	void worker(int id)
+	{
+		pinThread(id, numThreads, affinity);
+		while(true) {
+			startBarrier.wait();
+			if(quit) {
+				return;
+			}
+			while(phase.load(memory_order_relaxed) != PHASE_STOP) {
+				chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+				int aborts = body(id);
+				chrono::steady_clock::time_point end = chrono::steady_clock::now();
+				if(phase.load(memory_order_relaxed) == PHASE_MEASURE) {
+					stats[id].commits++;
+					stats[id].aborts += aborts;
+					stats[id].worstTime = max(stats[id].worstTime, chrono::duration<double>(end - begin).count());
+				}
+			}
+			stopBarrier.wait();
+		}
+	}
+};
+
+#endif /* HARNESS_H */
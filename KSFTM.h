@@ -10,9 +10,16 @@
 #include <atomic>
 #include <cstring>
 #include <mutex>
+#include <condition_variable>
+#include "VLock.h"
+#include "Trace.h"
+#include "Affinity.h"
+#include "TxAlloc.h"
 #include <algorithm>
 #include <iterator>
 #include <iostream>
+#include <chrono>
+#include <climits>
 
 using namespace std;
 
@@ -36,6 +43,43 @@ class TobIdValPair
 	long int val;
 };
 
+class LTransaction;
+
+/*
+ * Block freed by a committed transaction, kept in limbo until every live
+ * transaction has begun after the commit and reads versions newer than the
+ * freeing transaction's, so no transaction can still reach the block.
+ * */
+class LimboBlock
+{
+	//public members of the class
+	public:
+	void *ptr;
+	//counter value the live transactions must have passed, see releaseAllocs
+	long int stamp;
+};
+
+/*
+ * Announcement of a thread: the cts of the oldest top level transaction it
+ * runs, or NOT_LIVE while it runs none, and the blocks freed by its committed
+ * transactions that are not reused yet. Records are never freed; the record
+ * of a thread that has exited is taken, with its limbo, by the next thread.
+ * */
+class LiveRecord
+{
+	//public members of the class
+	public:
+	atomic<long int> cts;
+	//top level transactions of the thread begun and not yet finished
+	atomic<int> live;
+	//true while a live thread holds the record
+	atomic<bool> held;
+	//freed blocks waiting until no live transaction can reach them
+	vector<LimboBlock> limbo;
+	//next record of the library
+	LiveRecord *next = NULL;
+};
+
 /*
  * Global Transaction class : instances of this class class are stored in the
  * readers list of the versions of the transaction objects.
@@ -58,14 +102,32 @@ class GTransaction
 	long int g_tutl;
 	//Flag which is initially true and is false when transaction is aborted
 	bool g_valid;
+	//Flag which is true while the transaction runs irrevocably
+	bool g_irrevocable = false;
+	//parent transaction of a nested transaction, NULL for a top level transaction
+	LTransaction *g_parent = NULL;
+	//nested transactions committed into this transaction, NULL until the first one
+	list<GTransaction*> *nested = NULL;
+	//consecutive aborts of the nested transaction currently being retried
+	int g_nestedRetries = 0;
+	//pending commutative increments, sorted by id, NULL until the first one
+	vector<TobIdValPair> *add_set = NULL;
+	//blocks allocated by the transaction, chained through their headers
+	TxBlock *allocs = NULL;
+	//blocks freed by the transaction, put in limbo when it commits
+	vector<void*> *frees = NULL;
+	//record announcing the top level transaction, NULL for a nested one
+	LiveRecord *g_live = NULL;
+	//true while the flat combiner commits the transaction, whose owner then settles its memory and trace
+	bool g_combined = false;
 	//transaction objects locked by the current transaction
 	list<long int> *tobjs_locked = new list<long int>;
 	//transactions locked by the current transaction
 	list<GTransaction*> *trans_locked = new list<GTransaction*>;
 	//transation state - ABORT/LIVE/COMMIT
 	Transactionstate g_state;
-	//transaction specific lock
-	mutex* g_lock;
+	//transaction specific versioned lock word
+	VLock g_lock;
 	//Constructor
 	GTransaction();
 	//Private member of the not class.
@@ -110,6 +172,8 @@ class Version
 	long int val;
 	//transaction object's vrt
 	long int vrt;
+	//true if the version was created by a commutative increment
+	bool add = false;
 	//list of all transactions that have read value of the transaction object from this version
 	list<GTransaction*> *rl = new list<GTransaction*>;
 	//log max reader transaction
@@ -127,12 +191,83 @@ class Tobj
 	long int k;
 	//List of versions of the transaction object
 	list<Version*> *versionList = new list<Version*>;
-	//transcation object lock
-	mutex* tobj_lock;
+	//transcation object versioned lock word
+	VLock tobj_lock;
 	//constuctor
 	Tobj();
 };
 
+/*
+ * Contention counters of a transaction object. Only maintained when the
+ * library is compiled with -DCONTENTION_STATS; lock wait time and reader
+ * list length are sampled once every STATS_SAMPLE lock acquisitions.
+ * */
+class TobjStats
+{
+	//public members of the class
+	public:
+	//number of times the transaction object lock was acquired
+	atomic<long int> lockAcq;
+	//sampled lock wait time in nanoseconds and number of samples taken
+	atomic<long int> lockWaitNs;
+	atomic<long int> lockWaitSamples;
+	//sampled reader's list length of the version read
+	atomic<long int> rlLenSum;
+	atomic<long int> rlLenMax;
+	atomic<long int> rlSamples;
+	//versions erased from the version list to keep K versions
+	atomic<long int> evictions;
+	//aborts of transactions holding the transaction object lock
+	atomic<long int> aborts;
+};
+
+/*
+ * Commit request slot of a thread for the flat combining commit path. Only
+ * used when the library is compiled with -DFLAT_COMBINING; padded so that
+ * threads waiting on their slots do not share cache lines.
+ * */
+class CommitSlot
+{
+	//public members of the class
+	public:
+	//transaction waiting to be committed by the combiner, NULL if none
+	atomic<LTransaction*> request;
+	//outcome of the request, pending until the combiner has committed it
+	atomic<int> status;
+	char pad[64 - sizeof(atomic<LTransaction*>) - sizeof(atomic<int>)];
+};
+
+class KSFTM;
+
+/*
+ * Live record held by a thread, see LiveRecord. Kept in a thread_local, so
+ * the record is given back to the library when the thread exits.
+ * */
+class LiveRecordHolder
+{
+	//public members of the class
+	public:
+	//library the record belongs to, NULL if no record is held
+	KSFTM *lib = NULL;
+	LiveRecord *record = NULL;
+	~LiveRecordHolder();
+};
+
+/*
+ * Commit slot held by a thread for the flat combining commit path. Kept in
+ * a thread_local, so the slot goes back to the library's free list when
+ * the thread exits and a later thread can take it.
+ * */
+class CommitSlotHolder
+{
+	//public members of the class
+	public:
+	//library the slot belongs to, NULL if no slot is held
+	KSFTM *lib = NULL;
+	//index of the slot in the library's fcSlots, -1 if none is held
+	int slot = -1;
+	~CommitSlotHolder();
+};
 
 /*
  * STM class that provides the shared memory to all the transactions
@@ -158,25 +293,83 @@ class STM
 class KSFTM : public virtual STM	
 {
 	public:
-	//Constructor
-	KSFTM(int INITIAL_objs);	
+	//Constructor, the tobjs are allocated as the PlacementPolicy 'placement' says
+	KSFTM(int INITIAL_objs, int placement = PLACE_FIRST_TOUCH);	
 	
 	//Private member functions
 	private:
 		bool find_set(vector<TobIdValPair> *set, TobIdValPair* tobj_id_val_pair);
 		void insertAndSortRL(list<GTransaction*> *RL, GTransaction *gtrans);
-		void insertAndSortVL(Version *version, long int objId);
 		list<GTransaction*>* getLar(long int g_wts, long int g_cts, list<GTransaction*> *preVerRL);
 		list<GTransaction*>* getSm(long int g_wts, long int g_cts, list<GTransaction*> *preVerRL);
 		bool isAborted(GTransaction* gtrans);
 		void unlockAll(LTransaction *ltrans);
 		Version* findLTS_STL(long int g_wts, long int g_cts, long int tobj_id, Version**);
-				
-	//Public member functions	
-	public:	
+		Version* findLTS_pos(long int g_wts, long int g_cts, Tobj *tobj, list<Version*>::iterator *nextPos);
+		void lockTobj(long int objId);
+		void sampleRL(long int objId, long int rlLen);
+		bool tryCommit(LTransaction* trans, long int comTime);
+		bool combineCommit(LTransaction* trans);
+		int acquireSlot();
+		void releaseSlot(int slot);
+		void combine(int firstSlot);
+		bool disjointWrites(LTransaction* trans1, LTransaction* trans2);
+		bool disjointIds(vector<TobIdValPair> *set1, vector<TobIdValPair> *set2);
+		void endIrrevocable(LTransaction* trans);
+		bool find_nested(LTransaction* trans, TobIdValPair* tobj_id_val_pair);
+		bool takeAdd(LTransaction* trans, TobIdValPair* tobj_id_val_pair);
+		bool commitNested(LTransaction* trans);
+		void releaseAllocs(LTransaction* trans, bool committed);
+		LiveRecord* liveRecord();
+		void announce(LTransaction* trans);
+		void retire(LTransaction* trans);
+		void reclaim(LiveRecord* record);
+
+	//Private member variables
+	private:
+		//per transaction object contention counters, NULL when not compiled in
+		TobjStats *tobjStats = NULL;
+		//commits that passed the irrevocability gate and have not finished yet
+		atomic<long int> commitsInFlight;
+		//true while an irrevocable transaction is running
+		atomic<bool> irrevocableActive;
+		//held by the sole irrevocable transaction from tbegin to commit
+		VLock irrevocableLock;
+		//commit sequence numbers of the transaction objects, striped by id
+		atomic<long int> *commitSeq = NULL;
+		//transactions parked in stmRetry and the condition they wait on
+		atomic<long int> retryWaiters;
+		mutex retryMutex;
+		condition_variable retryCond;
+		//largest wts of a committed transaction, read-only ones included
+		atomic<long int> maxCommitWts;
+		//per thread commit request slots, NULL when flat combining is not compiled in
+		CommitSlot *fcSlots = NULL;
+		//held by the thread committing a batch of requests
+		VLock combinerLock;
+		//indices of the commit slots not held by any live thread
+		vector<int> *fcFree = NULL;
+		//guards fcFree
+		VLock fcFreeLock;
+		//live records of the threads that have run transactions, pushed at the head
+		atomic<LiveRecord*> liveRecords;
+	friend class CommitSlotHolder;
+	friend class LiveRecordHolder;
+
+	//Public member functions
+	public:
 		LTransaction* tbegin(long int its);
+		LTransaction* tbeginIrrevocable();
+		LTransaction* tbeginNested(LTransaction* parent);
 		bool stmRead(LTransaction* trans, TobIdValPair *tobj_id_val_pair);
 		bool stmWrite(LTransaction* trans, TobIdValPair *tobj_id_val_pair);
+		bool stmAdd(LTransaction* trans, long int tobj_id, long int delta);
 		bool stmTryCommit(LTransaction* trans);
 		bool stmAbort(LTransaction* trans);
+		bool stmRetry(LTransaction* trans);
+		bool stmRelease(LTransaction* trans, long int tobj_id);
+		void* stmMalloc(LTransaction* trans, size_t size);
+		void stmFree(LTransaction* trans, void *ptr);
+		void reportContention(int topN);
+		long int oldestLive();
 };
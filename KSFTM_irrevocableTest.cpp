@@ -0,0 +1,49 @@
+//  KSFTM_irrevocableTest.cpp
+//  Checks that an irrevocable transaction commits after an old read-only transaction
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+
+#include <iostream>
+#include "KSFTM.cpp"
+
+/*
+ * A transaction restarted with an old its gets a wts far above its cts.
+ * Once it commits having only read x, an irrevocable transaction that
+ * writes x must be ordered after it and commit, never abort.
+ * */
+int main()
+{
+	KSFTM *lib = new KSFTM(1);
+	TobIdValPair tobj_id_val_pair;
+	tobj_id_val_pair.id = 0;
+
+	//transactions that only advance the counter, so the reader below is old
+	long int oldIts = NIL;
+	for(int i = 0;i<100;i++) {
+		LTransaction *T = lib->tbegin(NIL);
+		if(oldIts == NIL) {
+			oldIts = T->g_its;
+		}
+		lib->stmTryCommit(T);
+	}
+
+	LTransaction *reader = lib->tbegin(oldIts);
+	if(lib->stmRead(reader, &tobj_id_val_pair) == ABORTED || lib->stmTryCommit(reader) == ABORTED) {
+		std::cout<<"FAILED: the read-only transaction aborted"<<std::endl;
+		return 1;
+	}
+
+	LTransaction *irrevocable = lib->tbeginIrrevocable();
+	if(irrevocable->g_wts <= reader->g_wts) {
+		std::cout<<"FAILED: irrevocable wts "<<irrevocable->g_wts<<" is not above the reader's "<<reader->g_wts<<std::endl;
+		return 1;
+	}
+	tobj_id_val_pair.val = 1;
+	if(lib->stmRead(irrevocable, &tobj_id_val_pair) == ABORTED || lib->stmWrite(irrevocable, &tobj_id_val_pair) == ABORTED
+		|| lib->stmTryCommit(irrevocable) == ABORTED) {
+		std::cout<<"FAILED: the irrevocable transaction aborted"<<std::endl;
+		return 1;
+	}
+	std::cout<<"PASSED"<<std::endl;
+	return 0;
+}
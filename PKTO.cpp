@@ -16,6 +16,7 @@
 #define ONE 1
 #define INFINITE 99999999;
 #define C 0.1
+#define TRACE(type, trans, tobj) STM_TRACE_EVENT(type, (trans)->id, (trans)->g_its, (trans)->g_cts, NIL, NIL, NIL, tobj)
 /**************************** CONSTRUCTORS *****************************/
 /*
  * Global Transaction(GTransaction) class constructor
@@ -23,7 +24,6 @@
 GTransaction::GTransaction()
 {
 	g_valid = TRUE;
-	g_lock = new mutex;
 }
 
 /*
@@ -31,15 +31,19 @@ GTransaction::GTransaction()
  * */
 Tobj::Tobj()
 {
-	tobj_lock = new mutex;
 }
 
 /*
  * Constructor of the class PKTO which performs the initialize operation. 
  * Invoked at the start of the STM system. Initializes all the tobjs used by the STM System.
  * */
-PKTO::PKTO(int INITIAL_objs)
+PKTO::PKTO(int INITIAL_objs, int placement)
 {
+	/*With PLACE_INTERLEAVE the pages first touched while the tobjs are
+	  built are spread over all the NUMA nodes, instead of all landing on
+	  the node of the thread calling the constructor*/
+	NumaPlacement numaPlacement(placement);
+	
 	g_tCntr.store(ONE);
 	
 	// For all the tobjs used by the STM System
@@ -322,7 +326,7 @@ void PKTO::unlockAll(LTransaction *ltrans)
 		list<GTransaction*>::iterator itr = ltrans->trans_locked->begin();
 		while(itr != ltrans->trans_locked->end())
 			{
-				(*itr)->g_lock->unlock();
+				(*itr)->g_lock.unlock();
 				itr++;
 			}
 	}
@@ -333,7 +337,7 @@ void PKTO::unlockAll(LTransaction *ltrans)
 		list<long int>::iterator iter = ltrans->tobjs_locked->begin();
 		while(iter != ltrans->tobjs_locked->end())
 			{
-			tobjs->at(*iter).tobj_lock->unlock();
+			tobjs->at(*iter).tobj_lock.unlock();
 			iter++;
 		}
 	}
@@ -364,6 +368,7 @@ LTransaction* PKTO::tbegin(long int its) {
 	trans->g_state = LIVE;
 	trans->g_valid = TRUE;
 	trans->comTime = INFINITE;
+	TRACE(TRACE_BEGIN, trans, NIL);
 	
 	return trans;
 }
@@ -393,10 +398,10 @@ bool PKTO::stmRead(LTransaction* ltrans, TobIdValPair* tobj_id_val_pair)
 		GTransaction *gtrans = ltrans;
 		
 		//Attain lock on transaction object
-	tobjs->at(tobj_id_val_pair->id).tobj_lock->lock();
+	tobjs->at(tobj_id_val_pair->id).tobj_lock.lock();
 	ltrans->tobjs_locked->push_back(tobj_id_val_pair->id);
 	//Attain lock on current transaction
-	ltrans->g_lock->lock();
+	ltrans->g_lock.lock();
 	ltrans->trans_locked->push_back(gtrans);
 	
 	//Abort the transaction is transaction's valid value is FALSE
@@ -424,6 +429,7 @@ bool PKTO::stmRead(LTransaction* ltrans, TobIdValPair* tobj_id_val_pair)
 	
 	//Unlock the transaction and unlock the transaction object
 	unlockAll(ltrans);
+	TRACE(TRACE_READ, ltrans, tobj_id_val_pair->id);
 	
 	//return OK
 	return OK;
@@ -441,6 +447,8 @@ bool PKTO::stmWrite(LTransaction* ltrans, TobIdValPair* tobj_id_val_pair)
 	//Flag to check weather the new transaction <id,val> pair is inserted or not
 	bool flag = FALSE;
 	
+	TRACE(TRACE_WRITE, ltrans, tobj_id_val_pair->id);
+	
 	//if write set of the transaction is empty insert the T<id,val> pair
 	if(ltrans->write_set->size() == ZERO) {
 		ltrans->write_set->push_back(*tobj_id_val_pair);
@@ -489,7 +497,7 @@ bool PKTO::stmTryCommit(LTransaction* ltrans)
 	list<long int>::iterator ver_iterator;
 	
 	//Optimization check for validaity of the transaction	
-	ltrans->g_lock->lock();
+	ltrans->g_lock.lock();
 	ltrans->trans_locked->push_back(gtrans);
 	if(ltrans->g_valid == FALSE) {
 		if(stmAbort(ltrans) == OK) {
@@ -497,14 +505,14 @@ bool PKTO::stmTryCommit(LTransaction* ltrans)
 		}
 	}
 	ltrans->trans_locked->clear();
-	ltrans->g_lock->unlock();
+	ltrans->g_lock.unlock();
 	
 	
 	//lock all transaction objects:x belongs to write_set of the transaction in pre-defined order.
 	for(int i = ZERO;i<ltrans->write_set->size();i++) {
 		objId = ltrans->write_set->at(i).id;
 		
-		tobjs->at(objId).tobj_lock->lock();
+		tobjs->at(objId).tobj_lock.lock();
 		ltrans->tobjs_locked->push_back(objId);
 		
 		//Find the Version with largest wts value less than g_wts of the transaction
@@ -512,7 +520,7 @@ bool PKTO::stmTryCommit(LTransaction* ltrans)
 		prevVer = findLTS_STL(ltrans->g_cts,objId);
 		//If no such version exists, abort the transaction and return ABORTED.
 		if(prevVer == NULL) {
-			ltrans->g_lock->lock();
+			ltrans->g_lock.lock();
 			ltrans->trans_locked->push_back(gtrans);
 			if(stmAbort(ltrans) == OK) {
 				return ABORTED;	
@@ -551,7 +559,7 @@ bool PKTO::stmTryCommit(LTransaction* ltrans)
 	while(gtran_list_iterator != largeRL->end())
     {
 		gtran_iterator = *gtran_list_iterator;
-		gtran_iterator->g_lock->lock();		
+		gtran_iterator->g_lock.lock();		
 		ltrans->trans_locked->push_back(gtran_iterator);
 		gtran_list_iterator++;
 	}
@@ -616,6 +624,8 @@ bool PKTO::stmTryCommit(LTransaction* ltrans)
 	//unlock all the variables
 	unlockAll(ltrans);
 
+	TRACE(TRACE_COMMIT, ltrans, NIL);
+	
 	//return OK
 	return OK;
 }
@@ -632,6 +642,7 @@ bool PKTO::stmAbort(LTransaction* ltrans)
 		ltrans->g_state = ABORT;
 		//unlock all the variables
 		unlockAll(ltrans);
+		TRACE(TRACE_ABORT, ltrans, NIL);
 		//Return OK status		
 		return OK;
 	}
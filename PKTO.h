@@ -9,6 +9,9 @@
 #include <atomic>
 #include <cstring>
 #include <mutex>
+#include "VLock.h"
+#include "Trace.h"
+#include "Affinity.h"
 #include <algorithm>
 #include <iterator>
 #include <iostream>
@@ -58,8 +61,8 @@ class GTransaction
 	list<GTransaction*> *trans_locked = new list<GTransaction*>;
 	//transation state - ABORT/LIVE/COMMIT
 	Transactionstate g_state;
-	//transaction specific lock
-	mutex* g_lock;
+	//transaction specific versioned lock word
+	VLock g_lock;
 	//Constructor
 	GTransaction();
 	//Private member of the not class.
@@ -115,8 +118,8 @@ class Tobj
 	long int k;
 	//List of versions of the transaction object
 	list<Version*> *versionList = new list<Version*>;
-	//transcation object lock
-	mutex* tobj_lock;
+	//transcation object versioned lock word
+	VLock tobj_lock;
 	//constuctor
 	Tobj();
 };
@@ -146,8 +149,8 @@ class STM
 class PKTO : public virtual STM	
 {
 	public:
-	//Constructor
-	PKTO(int INITIAL_objs);	
+	//Constructor, the tobjs are allocated as the PlacementPolicy 'placement' says
+	PKTO(int INITIAL_objs, int placement = PLACE_FIRST_TOUCH);	
 	
 	//Private member functions
 	private:
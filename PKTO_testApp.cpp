@@ -4,213 +4,104 @@
 //  Copyright © 2019 IIT-HYD. All rights reserved.
 
 
-#include <sys/time.h>
-#include <unistd.h>
 #include <random>
 #include <fstream>
 #include <iostream>
-#include <pthread.h>
 #include "PKTO.cpp"
+#include "Workload.h"
+#include "Harness.h"
 # include <mutex>
 
-#define READ 0
-#define WRITE 1
-
-#define OP_DEL 100
-#define WRITE_VAL 1000
-#define OP_SEED 100
-
 #define T_OBJ_SEED 5
 #define OP_LT_SEED 10
 
+#ifndef NUM_THREADS
 #define NUM_THREADS 250
-#define TRANS_LT NUM_THREADS 
+#endif
 
-#define READ_PER 10
+//measurements, and the warmup and timed steady state of each in milliseconds
+#ifndef ITERATIONS
+#define ITERATIONS 1
+#endif
+#ifndef WARMUP_MS
+#define WARMUP_MS 50
+#endif
+#ifndef DURATION_MS
+#define DURATION_MS 200
+#endif
 
-using namespace std;
+#define READ_PER 10
 
-double timee[NUM_THREADS];
+//key space and distribution of the transaction objects, see Workload.h
+#ifndef KEY_SPACE
+#define KEY_SPACE T_OBJ_SEED
+#endif
+#ifndef KEY_DIST
+#define KEY_DIST KEY_UNIFORM
+#endif
 
-PKTO* lib = new PKTO(T_OBJ_SEED);
-//Transaction Limit atomic counter
-atomic<int> transLt;
+//shares of short read-write, read-only scan and blind write transactions
+#ifndef RW_WEIGHT
+#define RW_WEIGHT 100
+#endif
+#ifndef SCAN_WEIGHT
+#define SCAN_WEIGHT 0
+#endif
+#ifndef BLIND_WEIGHT
+#define BLIND_WEIGHT 0
+#endif
+#ifndef SCAN_LEN
+#define SCAN_LEN 50
+#endif
 
-atomic<int> RabortCnt;
-atomic<int> WabortCnt;
+//seed of the per thread generators; runs with the same seed issue the same transactions
+#ifndef WORKLOAD_SEED
+#define WORKLOAD_SEED 1
+#endif
 
-double timeRequest() {
-  struct timeval tp;
-  gettimeofday(&tp, NULL);
-  double timevalue = tp.tv_sec + (tp.tv_usec/1000000.0);
-  return timevalue;
-}
+//AffinityPolicy of the worker threads and PlacementPolicy of the tobjs, see Affinity.h
+#ifndef AFFINITY
+#define AFFINITY AFFINITY_NONE
+#endif
+#ifndef OBJ_PLACEMENT
+#define OBJ_PLACEMENT PLACE_FIRST_TOUCH
+#endif
 
-class TestAppln {
-	
-	int numOps, readPer, opDel;
-	int opSeed, opLtSeed, tobjSeed, writeVal;
-	int currTObj,randVal,currOp;
-	
-	public:
-	TestAppln();
-	int testFunc();	
-};
+using namespace std;
 
-TestAppln::TestAppln() {
-	
-	readPer = READ_PER;
-	opDel = OP_DEL;
-	opSeed = OP_SEED;
-	opLtSeed = OP_LT_SEED;
-	tobjSeed = T_OBJ_SEED;
-	writeVal = WRITE_VAL;
-}
-int TestAppln::testFunc() {
-	
-	LTransaction* T = new LTransaction;
-	T->g_its = NIL;
-	
-	int localAbortCnt = 0;
-	
-	label: while(true) {
-		if(T->g_its != NIL) {
-			long int its = T->g_its;
-			T = lib->tbegin(its);
-		} else {
-			T = lib->tbegin(T->g_its);
-		}
-		
-		// Generate the number of operations to execute in this transaction
-		numOps = rand()%opLtSeed;
-		for(int opCnt = 0; opCnt < 10; opCnt++) {
-		/* Generate the tobj on which the next tobj will execute
-					returns a random value in the range 1 - tobjSeed*/
-			currTObj = rand()%tobjSeed;
+PKTO* lib = new PKTO(KEY_SPACE, OBJ_PLACEMENT);
+Workload<PKTO>* workload = new Workload<PKTO>(lib, KEY_SPACE, KEY_DIST, NUM_THREADS, WORKLOAD_SEED);
+//pool of worker threads; the class counters of the workload count only while it measures
+Harness* harness = NULL;
 
-			/* Generate the next operation based on the percentage
-			   Generate a random value between 0 - 100 */
-			randVal = rand()%opSeed;
-			if (randVal <= readPer) {
-				currOp = READ;
-			} else {
-				currOp = WRITE;
-			}					
-			// Take the appropriate action depending on the current operation
-			TobIdValPair *tobj_id_val_pair = new TobIdValPair;
-			switch(currOp) {
-				case READ:
-					tobj_id_val_pair->id = currTObj;
-					// If the read operation aborts then restart the transaction
-					if(lib->stmRead(T, tobj_id_val_pair) == ABORTED) {
-						RabortCnt++;
-						localAbortCnt++;
-						goto label;
-					}
-					break;
-				
-				case WRITE:
-					tobj_id_val_pair->id = currTObj;
-					tobj_id_val_pair->val = rand()%writeVal;
-					lib->stmWrite(T,tobj_id_val_pair);
-					break;
-			}
-			// Sleep for random time between each operation. Simulates the thread performing some operation
-			//usleep(rand()%opDel);
-		}// End for numOps
-		
-		/* Try to commit the current transaction.
-		   If stmTryCommit returns ABORTED then retry this transaction again. */
-		if(lib->stmTryCommit(T) == ABORTED) {
-			WabortCnt++;
-			localAbortCnt++;
-			continue;
-		}
-		// Break out of the while loop since the transaction has committed
-		break;
-	} // End while true			
-		
-	return localAbortCnt;
-}// End TestFunc
-	
-void* testFunc_helper(void *ptr_id)
-{
-	int id = *((int*)ptr_id);
-	double btime,etime;
-	int transLmt = transLt.fetch_add(ONE);
-	TestAppln* testAppl = new TestAppln;
-	
-	// Execute this loop until the transLt number of transactions execute successfully
-	while(transLmt < TRANS_LT) {
-		//begin time
-		btime = timeRequest();
-		
-		int localAbortCnt = testAppl->testFunc();
-		
-		//end time
-		etime = timeRequest();
-		
-		timee[id] = timee[id] + (etime - btime);
-		
-		transLmt = transLt.fetch_add(ONE);
-	}// End for transLt
-}
-	
 int main()
 {
-	double sumTime=0.0,btime,etime;
-	long readAbort = 0, writeAbort =0;
-	
-	
-	int threadId[NUM_THREADS], k = 0;
-	while(k<NUM_THREADS)
-	{
-		timee[k] = 0;
-		threadId[k] = k;
-		k++;
-	} 
-	transLt.store(ZERO);
-	RabortCnt.store(ZERO);
-	WabortCnt.store(ZERO);
-	
-	pthread_t threads[NUM_THREADS];
-	int loop =0;
-	//while(loop<5) {
-	
-	//btime = timeRequest();
-		
-		for (int i=0; i < NUM_THREADS; i++) {
-			pthread_create(&threads[i], NULL, testFunc_helper, &threadId[i]);
-		}
-		
-		//only after all the threads join, the parent has to exit
-		for(int i=0; i< NUM_THREADS; i++) {
-			  pthread_join(threads[i],NULL); 
-		}
-	//etime = timeRequest();		
-		loop++;
-		k = 0;
-		double max_time = 0.0;
-		while(k<NUM_THREADS)
-		{
-			if(max_time<timee[k])
-				max_time = timee[k];
-			k++;
-		}
-		
-		readAbort += RabortCnt.load();
-		writeAbort += WabortCnt.load();
-		transLt.store(ZERO);
-		RabortCnt.store(ZERO);
-		WabortCnt.store(ZERO);
-	//}	
-	
+	workload->addClass(TX_SHORT_RW, RW_WEIGHT, OP_LT_SEED, READ_PER);
+	workload->addClass(TX_SCAN, SCAN_WEIGHT, SCAN_LEN, 100);
+	workload->addClass(TX_BLIND_WRITE, BLIND_WEIGHT, OP_LT_SEED, 0);
+	
+	//the threads are created once; every measurement times only the steady state after its warmup
+	harness = new Harness(NUM_THREADS, [](int id) { return workload->run(id, harness); }, AFFINITY);
+	NumaCounters numaBefore;
+	long int commits = 0, aborts = 0;
+	double seconds = 0.0, max_time = 0.0;
+	for(int loop = 0;loop<ITERATIONS;loop++) {
+		HarnessResult result = harness->measure(WARMUP_MS, DURATION_MS);
+		commits += result.commits;
+		aborts += result.aborts;
+		seconds += result.seconds;
+		max_time = max(max_time, result.worstTime);
+	}
+	NumaCounters numaAfter;
+	delete harness;
+	
+	cout<<"Throughput (commits/s) : "<<commits/seconds<<"  Aborts : "<<aborts<<endl;
 	cout<<"Worst time calculated "<<max_time<<endl;
+	numaAfter.report(numaBefore);
 	
+	//commits and aborts of every transaction class
+	workload->report();
 	
-	//cout<<"\nAverage Time for 5 iterations "<<total_time/1.0<<" RAbrtCnt "<<readAbort/1<<" WAbrtCnt  "<<writeAbort/1<<" Total Abort "<<readAbort+writeAbort<<endl;
 	//cout<<"Total memory allocated to the versions is -> "<<totalVersions<<"\nTotal memory allocated to the read list nodes is ->"<<totalReadListNodes<<endl;
-	pthread_exit(NULL);
-    
-    return 0;
+	return 0;
 }
@@ -0,0 +1,73 @@
+//  Random.h
+//  Per thread pseudo random number generator for the test applications
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+/*
+ * xoshiro256** generator of Blackman and Vigna. Every thread owns one, so
+ * drawing a number takes no lock, unlike rand(). Padded to a cache line so
+ * that generators kept in an array are not falsely shared.
+ * */
+class Xoshiro256
+{
+	//public members of the class
+	public:
+	typedef uint64_t result_type;
+
+	//the state is expanded from 'seed' with splitmix64, as its authors advise
+	Xoshiro256(uint64_t seed = 1)
+	{
+		for(int i = 0;i<4;i++) {
+			seed += 0x9e3779b97f4a7c15ULL;
+			uint64_t z = seed;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+			s[i] = z ^ (z >> 31);
+		}
+	}
+
+	uint64_t operator()()
+	{
+		uint64_t result = rotl(s[1] * 5, 7) * 9;
+		uint64_t t = s[1] << 17;
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = rotl(s[3], 45);
+		return result;
+	}
+
+	//uniform in [0, n), by multiplying instead of dividing
+	long int below(long int n)
+	{
+		return (long int)(((unsigned __int128)(*this)() * (uint64_t)n) >> 64);
+	}
+
+	//uniform in [0, 1)
+	double uniform()
+	{
+		return ((*this)() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	static constexpr uint64_t min() { return 0; }
+	static constexpr uint64_t max() { return UINT64_MAX; }
+
+	//private members of the class
+	private:
+	uint64_t s[4];
+	char pad[64 - 4*sizeof(uint64_t)];
+
+	static uint64_t rotl(uint64_t x, int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+};
+
+#endif /* RANDOM_H */
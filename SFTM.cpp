@@ -14,6 +14,7 @@
 #define ZERO 0
 #define ONE 1
 #define INFINITE 99999999;
+#define TRACE(type, trans, tobj) STM_TRACE_EVENT(type, (trans)->id, (trans)->g_its, (trans)->g_cts, NIL, NIL, NIL, tobj)
 /**************************** CONSTRUCTORS *****************************/
 /*
  * Global Transaction(GTransaction) class constructor
@@ -21,7 +22,6 @@
 GTransaction::GTransaction()
 {
 	g_valid = TRUE;
-	g_lock = new mutex;
 }
 
 /*
@@ -29,15 +29,19 @@ GTransaction::GTransaction()
  * */
 Tobj::Tobj()
 {
-	tobj_lock = new mutex;
 }
 
 /*
  * Constructor of the class SFTM which performs the initialize operation. 
  * Invoked at the start of the STM system. Initializes all the tobjs used by the STM System.
  * */
-SFTM::SFTM(int INITIAL_objs)
+SFTM::SFTM(int INITIAL_objs, int placement)
 {
+	/*With PLACE_INTERLEAVE the pages first touched while the tobjs are
+	  built are spread over all the NUMA nodes, instead of all landing on
+	  the node of the thread calling the constructor*/
+	NumaPlacement numaPlacement(placement);
+	
 	g_tCntr.store(ONE);
 	
 	// For all the tobjs used by the STM System
@@ -168,7 +172,7 @@ void SFTM::unlockAll(LTransaction *ltrans)
 		while(gtran_list_iterator != ltrans->trans_locked->end())
 		{
 			gtran_iterator = *gtran_list_iterator;
-			gtran_iterator->g_lock->unlock();
+			gtran_iterator->g_lock.unlock();
 			++gtran_list_iterator;
 		}
 	}
@@ -180,7 +184,7 @@ void SFTM::unlockAll(LTransaction *ltrans)
 		while(transObj_list_iterator != ltrans->tobjs_locked->end())
 		{
 			tranObj_iterator = *transObj_list_iterator;
-			tobjs->at(tranObj_iterator).tobj_lock->unlock();
+			tobjs->at(tranObj_iterator).tobj_lock.unlock();
 			++transObj_list_iterator;
 		}
 	}
@@ -193,7 +197,7 @@ void SFTM::unlockAll(LTransaction *ltrans)
 		list<GTransaction*>::iterator itr = ltrans->trans_locked->begin();
 		while(itr != ltrans->trans_locked->end())
 			{
-				(*itr)->g_lock->unlock();
+				(*itr)->g_lock.unlock();
 				itr++;
 			}
 	}
@@ -204,7 +208,7 @@ void SFTM::unlockAll(LTransaction *ltrans)
 		list<long int>::iterator iter = ltrans->tobjs_locked->begin();
 		while(iter != ltrans->tobjs_locked->end())
 			{
-			tobjs->at(*iter).tobj_lock->unlock();
+			tobjs->at(*iter).tobj_lock.unlock();
 			iter++;
 		}
 	}
@@ -235,6 +239,7 @@ LTransaction* SFTM::tbegin(long int its) {
 	//set status and valid of the transaction		
 	ltrans->g_state = LIVE;
 	ltrans->g_valid = TRUE;
+	TRACE(TRACE_BEGIN, ltrans, NIL);
 	
 	//return local transaction pointer reference		
 	return ltrans;
@@ -266,10 +271,10 @@ bool SFTM::stmRead(LTransaction* ltrans, TobIdValPair *tobj_id_val_pair)
 	}
 	
 	//Attain lock on transaction object
-	tobjs->at(tobj_id_val_pair->id).tobj_lock->lock();
+	tobjs->at(tobj_id_val_pair->id).tobj_lock.lock();
 	ltrans->tobjs_locked->push_back(tobj_id_val_pair->id);
 	//Attain lock on current transaction
-	ltrans->g_lock->lock();
+	ltrans->g_lock.lock();
 	ltrans->trans_locked->push_back(gtrans);
 	
 	//Abort the transaction is transaction's valid value is FALSE
@@ -309,6 +314,7 @@ bool SFTM::stmRead(LTransaction* ltrans, TobIdValPair *tobj_id_val_pair)
 		
 	//Unlock the transaction and unlock the transaction object
 	unlockAll(ltrans);
+	TRACE(TRACE_READ, ltrans, tobj_id_val_pair->id);
 	
 	//return OK
 	return OK;
@@ -326,6 +332,8 @@ bool SFTM::stmWrite(LTransaction* ltrans, TobIdValPair* tobj_id_val_pair)
 	//Flag to check weather the new transaction <id,val> pair is inserted or not
 	bool flag = FALSE;
 	
+	TRACE(TRACE_WRITE, ltrans, tobj_id_val_pair->id);
+	
 	//if write set of the transaction is empty insert the T<id,val> pair
 	if(ltrans->write_set->size() == ZERO) {
 		ltrans->write_set->push_back(*tobj_id_val_pair);
@@ -374,7 +382,7 @@ bool SFTM::stmTryCommit(LTransaction* ltrans)
 	
 	
 	//Optimization check for validaity of the transaction	
-	ltrans->g_lock->lock();
+	ltrans->g_lock.lock();
 	ltrans->trans_locked->push_back(gtrans);
 	if(ltrans->g_valid == FALSE) {
 		if(stmAbort(ltrans) == OK) {
@@ -382,7 +390,7 @@ bool SFTM::stmTryCommit(LTransaction* ltrans)
 		}
 	}
 	ltrans->trans_locked->clear();
-	ltrans->g_lock->unlock();
+	ltrans->g_lock.unlock();
 		
 	//lock all transaction objects:x belongs to write_set and read_set of the transaction in pre-defined order.
 	if(ltrans->read_set->size() != 0)
@@ -398,7 +406,7 @@ bool SFTM::stmTryCommit(LTransaction* ltrans)
 	
 	for(int i = ZERO;i < ltrans->write_set->size();i++) {
 		objId = ltrans->write_set->at(i).id;
-			tobjs->at(objId).tobj_lock->lock();
+			tobjs->at(objId).tobj_lock.lock();
 			ltrans->tobjs_locked->push_back(objId);
 	}
 	
@@ -431,7 +439,7 @@ bool SFTM::stmTryCommit(LTransaction* ltrans)
 	while(gtran_list_iterator != TSet->end())
 	{
 		gtran_iterator = *gtran_list_iterator;
-		gtran_iterator->g_lock->lock();
+		gtran_iterator->g_lock.lock();
 		ltrans->trans_locked->push_back(gtran_iterator);
 		gtran_list_iterator++;
 	}
@@ -453,7 +461,7 @@ bool SFTM::stmTryCommit(LTransaction* ltrans)
 					if(gtran_iterator->g_state == LIVE) {
 						gtran_iterator->g_valid = FALSE;
 					}
-					gtran_iterator->g_lock->unlock();
+					gtran_iterator->g_lock.unlock();
 				}
 				gtran_list_iterator++;
 			}
@@ -481,6 +489,8 @@ bool SFTM::stmTryCommit(LTransaction* ltrans)
 	//unlock all the variables
 	unlockAll(ltrans);
 	
+	TRACE(TRACE_COMMIT, ltrans, NIL);
+	
 	//return OK
 	return OK;
 }
@@ -498,6 +508,7 @@ bool SFTM::stmAbort(LTransaction* ltrans)
 		
 		//unlock all the variables
 		unlockAll(ltrans);
+		TRACE(TRACE_ABORT, ltrans, NIL);
 		//Return OK status		
 		return OK;
 	}
@@ -8,6 +8,9 @@
 #include <list>
 #include <atomic>
 #include <mutex>
+#include "VLock.h"
+#include "Trace.h"
+#include "Affinity.h"
 #include <iterator>
 #include <iostream>
 #include <algorithm>
@@ -52,8 +55,8 @@ class GTransaction
 	list<GTransaction*> *trans_locked = new list<GTransaction*>;
 	//transation state - ABORT/LIVE/COMMIT
 	Transactionstate g_state;
-	//transaction specific lock
-	mutex* g_lock;
+	//transaction specific versioned lock word
+	VLock g_lock;
 	//Constructor
 	GTransaction();
 	//Private member of the not class.
@@ -90,8 +93,8 @@ class Tobj
 	long int val;
 	//list of all transactions that have read value of the transaction object from this version
 	list<GTransaction*> *rl = new list<GTransaction*>;
-	//transcation object lock
-	mutex* tobj_lock;
+	//transcation object versioned lock word
+	VLock tobj_lock;
 	//constuctor
 	Tobj();
 };
@@ -119,8 +122,8 @@ class STM
 class SFTM : public STM	
 {
 	public:
-	//Constructor
-	SFTM(int INITIAL_objs);	
+	//Constructor, the tobjs are allocated as the PlacementPolicy 'placement' says
+	SFTM(int INITIAL_objs, int placement = PLACE_FIRST_TOUCH);	
 	
 	//Private member functions
 	private:
@@ -0,0 +1,39 @@
+# ==============================================================================
+#
+# Defines.common.mk
+#
+# ==============================================================================
+
+
+CFLAGS += -DLIST_NO_DUPLICATES
+CFLAGS += -DLEARNER_TRY_REMOVE
+CFLAGS += -DLEARNER_TRY_REVERSE
+
+LIBS += -lm
+
+PROG := bayes
+
+SRCS += \
+	adtree.c \
+	bayes.c \
+	data.c \
+	learner.c \
+	net.c \
+	query.c \
+	sort.c \
+	$(LIB)/bitmap.c \
+	$(LIB)/list.c \
+	$(LIB)/mt19937ar.c \
+	$(LIB)/queue.c \
+	$(LIB)/random.c \
+	$(LIB)/thread.c \
+	$(LIB)/vector.c \
+#
+OBJS := ${SRCS:.c=.o}
+
+
+# ==============================================================================
+#
+# End of Defines.common.mk
+#
+# ==============================================================================
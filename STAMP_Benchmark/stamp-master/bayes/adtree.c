@@ -0,0 +1,444 @@
+/* =============================================================================
+ *
+ * adtree.c
+ *
+ * =============================================================================
+ *
+ * Copyright (C) Stanford University, 2006.  All Rights Reserved.
+ * Author: Chi Cao Minh
+ *
+ * =============================================================================
+ *
+ * For the license of bayes/sort.h and bayes/sort.c, please see the header
+ * of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of kmeans, please see kmeans/LICENSE.kmeans
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of ssca2, please see ssca2/COPYRIGHT
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/mt19937ar.c and lib/mt19937ar.h, please see the
+ * header of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/rbtree.h and lib/rbtree.c, please see
+ * lib/LEGALNOTICE.rbtree and lib/LICENSE.rbtree
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * Unless otherwise noted, the following license applies to STAMP files:
+ * 
+ * Copyright (c) 2007, Stanford University
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ * 
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ * 
+ *     * Neither the name of Stanford University nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY STANFORD UNIVERSITY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL STANFORD UNIVERSITY BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * =============================================================================
+ */
+
+
+
+#include <assert.h>
+#include <stdlib.h>
+#include "adtree.h"
+#include "data.h"
+#include "query.h"
+#include "vector.h"
+
+
+/* =============================================================================
+ * allocNode
+ * =============================================================================
+ */
+static adtree_node_t*
+allocNode (long index)
+{
+    adtree_node_t* nodePtr;
+
+    nodePtr = (adtree_node_t*)malloc(sizeof(adtree_node_t));
+    if (nodePtr) {
+        nodePtr->varyVectorPtr = vector_alloc(1);
+        if (nodePtr->varyVectorPtr == NULL) {
+            free(nodePtr);
+            return NULL;
+        }
+        nodePtr->index = index;
+        nodePtr->value = -1;
+        nodePtr->count = -1;
+    }
+
+    return nodePtr;
+}
+
+
+/* =============================================================================
+ * allocVary
+ * =============================================================================
+ */
+static adtree_vary_t*
+allocVary (long index)
+{
+    adtree_vary_t* varyPtr;
+
+    varyPtr = (adtree_vary_t*)malloc(sizeof(adtree_vary_t));
+    if (varyPtr) {
+        varyPtr->index = index;
+        varyPtr->mostCommonValue = -1;
+        varyPtr->zeroNodePtr = NULL;
+        varyPtr->oneNodePtr = NULL;
+    }
+
+    return varyPtr;
+}
+
+
+static void
+freeVary (adtree_vary_t* varyPtr);
+
+
+/* =============================================================================
+ * freeNode
+ * =============================================================================
+ */
+static void
+freeNode (adtree_node_t* nodePtr)
+{
+    vector_t* varyVectorPtr = nodePtr->varyVectorPtr;
+    long numVary = vector_getSize(varyVectorPtr);
+    long v;
+    for (v = 0; v < numVary; v++) {
+        freeVary((adtree_vary_t*)vector_at(varyVectorPtr, v));
+    }
+    vector_free(varyVectorPtr);
+    free(nodePtr);
+}
+
+
+/* =============================================================================
+ * freeVary
+ * =============================================================================
+ */
+static void
+freeVary (adtree_vary_t* varyPtr)
+{
+    if (varyPtr->zeroNodePtr) {
+        freeNode(varyPtr->zeroNodePtr);
+    }
+    if (varyPtr->oneNodePtr) {
+        freeNode(varyPtr->oneNodePtr);
+    }
+    free(varyPtr);
+}
+
+
+/* =============================================================================
+ * adtree_alloc
+ * =============================================================================
+ */
+adtree_t*
+adtree_alloc ()
+{
+    adtree_t* adtreePtr;
+
+    adtreePtr = (adtree_t*)malloc(sizeof(adtree_t));
+    if (adtreePtr) {
+        adtreePtr->numVar = -1L;
+        adtreePtr->numRecord = -1L;
+        adtreePtr->rootNodePtr = NULL;
+    }
+
+    return adtreePtr;
+}
+
+
+/* =============================================================================
+ * adtree_free
+ * =============================================================================
+ */
+void
+adtree_free (adtree_t* adtreePtr)
+{
+    if (adtreePtr->rootNodePtr) {
+        freeNode(adtreePtr->rootNodePtr);
+    }
+    free(adtreePtr);
+}
+
+
+static adtree_node_t*
+makeNode (long parentIndex,
+          long index,
+          long start,
+          long numRecord,
+          data_t* dataPtr);
+
+
+/* =============================================================================
+ * makeVary
+ * =============================================================================
+ */
+static adtree_vary_t*
+makeVary (long parentIndex,
+          long index,
+          long start,
+          long numRecord,
+          data_t* dataPtr)
+{
+    adtree_vary_t* varyPtr = allocVary(index);
+    assert(varyPtr);
+
+    /* The records of the parent are already sorted from parentIndex+1 on */
+    if ((parentIndex + 1 != index) && (numRecord > 1)) {
+        data_sort(dataPtr, start, numRecord, index);
+    }
+
+    long num0 = data_findSplit(dataPtr, start, numRecord, index);
+    long num1 = numRecord - num0;
+
+    long mostCommonValue = ((num0 >= num1) ? 0 : 1);
+    varyPtr->mostCommonValue = mostCommonValue;
+
+    if (num0 == 0 || mostCommonValue == 0) {
+        varyPtr->zeroNodePtr = NULL;
+    } else {
+        varyPtr->zeroNodePtr = makeNode(index, index, start, num0, dataPtr);
+        varyPtr->zeroNodePtr->value = 0;
+    }
+
+    if (num1 == 0 || mostCommonValue == 1) {
+        varyPtr->oneNodePtr = NULL;
+    } else {
+        varyPtr->oneNodePtr =
+            makeNode(index, index, (start + num0), num1, dataPtr);
+        varyPtr->oneNodePtr->value = 1;
+    }
+
+    return varyPtr;
+}
+
+
+/* =============================================================================
+ * makeNode
+ * =============================================================================
+ */
+static adtree_node_t*
+makeNode (long parentIndex,
+          long index,
+          long start,
+          long numRecord,
+          data_t* dataPtr)
+{
+    adtree_node_t* nodePtr = allocNode(index);
+    assert(nodePtr);
+
+    nodePtr->count = numRecord;
+
+    vector_t* varyVectorPtr = nodePtr->varyVectorPtr;
+
+    long v;
+    long numVar = dataPtr->numVar;
+    for (v = (index + 1); v < numVar; v++) {
+        adtree_vary_t* varyPtr =
+            makeVary(parentIndex, v, start, numRecord, dataPtr);
+        assert(varyPtr);
+        bool_t status = vector_pushBack(varyVectorPtr, (void*)varyPtr);
+        assert(status);
+    }
+
+    return nodePtr;
+}
+
+
+/* =============================================================================
+ * adtree_make
+ * -- Records in dataPtr are sorted as the tree is made
+ * =============================================================================
+ */
+void
+adtree_make (adtree_t* adtreePtr, data_t* dataPtr)
+{
+    long numRecord = dataPtr->numRecord;
+    adtreePtr->numVar = dataPtr->numVar;
+    adtreePtr->numRecord = dataPtr->numRecord;
+    data_sort(dataPtr, 0, numRecord, 0);
+    adtreePtr->rootNodePtr = makeNode(-1, -1, 0, numRecord, dataPtr);
+}
+
+
+/* =============================================================================
+ * getCount
+ * =============================================================================
+ */
+static long
+getCount (adtree_node_t* nodePtr,
+          long i,
+          long q,
+          vector_t* queryVectorPtr,
+          long lastQueryIndex,
+          adtree_t* adtreePtr)
+{
+    if (nodePtr == NULL) {
+        return 0;
+    }
+
+    long nodeIndex = nodePtr->index;
+    if (nodeIndex >= lastQueryIndex) {
+        return nodePtr->count;
+    }
+
+    long count = 0L;
+
+    query_t* queryPtr = (query_t*)vector_at(queryVectorPtr, q);
+    if (!queryPtr) {
+        return nodePtr->count;
+    }
+    long queryIndex = queryPtr->index;
+    assert(queryIndex <= lastQueryIndex);
+    vector_t* varyVectorPtr = nodePtr->varyVectorPtr;
+    adtree_vary_t* varyPtr =
+        (adtree_vary_t*)vector_at(varyVectorPtr, (queryIndex - nodeIndex - 1));
+    assert(varyPtr);
+
+    long queryValue = queryPtr->value;
+
+    if (queryValue == varyPtr->mostCommonValue) {
+
+        /*
+         * We do not explicitly store the counts for the most common value.
+         * We can calculate it by finding the count of the query without
+         * the current (superCount) and subtracting the count for the
+         * query with the current toggled (invertCount).
+         */
+        long numQuery = vector_getSize(queryVectorPtr);
+        vector_t* superQueryVectorPtr = PVECTOR_ALLOC(numQuery - 1);
+        assert(superQueryVectorPtr);
+
+        long qq;
+        for (qq = 0; qq < numQuery; qq++) {
+            if (qq != q) {
+                bool_t status = PVECTOR_PUSHBACK(superQueryVectorPtr,
+                                                 vector_at(queryVectorPtr, qq));
+                assert(status);
+            }
+        }
+        long superCount = adtree_getCount(adtreePtr, superQueryVectorPtr);
+
+        PVECTOR_FREE(superQueryVectorPtr);
+
+        long invertCount;
+        if (queryValue == 0) {
+            queryPtr->value = 1;
+            invertCount = getCount(nodePtr,
+                                   i,
+                                   q,
+                                   queryVectorPtr,
+                                   lastQueryIndex,
+                                   adtreePtr);
+            queryPtr->value = 0;
+        } else {
+            queryPtr->value = 0;
+            invertCount = getCount(nodePtr,
+                                   i,
+                                   q,
+                                   queryVectorPtr,
+                                   lastQueryIndex,
+                                   adtreePtr);
+            queryPtr->value = 1;
+        }
+        count += superCount - invertCount;
+
+    } else {
+
+        if (queryValue == 0) {
+            count += getCount(varyPtr->zeroNodePtr,
+                              (i + 1),
+                              (q + 1),
+                              queryVectorPtr,
+                              lastQueryIndex,
+                              adtreePtr);
+        } else if (queryValue == 1) {
+            count += getCount(varyPtr->oneNodePtr,
+                              (i + 1),
+                              (q + 1),
+                              queryVectorPtr,
+                              lastQueryIndex,
+                              adtreePtr);
+        } else { /* QUERY_VALUE_WILDCARD */
+            assert(0); /* wildcards are left out of the query vector */
+        }
+
+    }
+
+    return count;
+}
+
+
+/* =============================================================================
+ * adtree_getCount
+ * -- queryVector must be sorted by index, and no value may be a wildcard
+ * -- The values of the queries are restored before returning
+ * =============================================================================
+ */
+long
+adtree_getCount (adtree_t* adtreePtr, vector_t* queryVectorPtr)
+{
+    adtree_node_t* rootNodePtr = adtreePtr->rootNodePtr;
+    if (rootNodePtr == NULL) {
+        return 0L;
+    }
+
+    long lastQueryIndex = -1L;
+    long numQuery = vector_getSize(queryVectorPtr);
+    if (numQuery > 0) {
+        query_t* lastQueryPtr =
+            (query_t*)vector_at(queryVectorPtr, (numQuery - 1));
+        lastQueryIndex = lastQueryPtr->index;
+    }
+
+    return getCount(rootNodePtr,
+                    -1,
+                    0,
+                    queryVectorPtr,
+                    lastQueryIndex,
+                    adtreePtr);
+}
+
+
+/* =============================================================================
+ *
+ * End of adtree.c
+ *
+ * =============================================================================
+ */
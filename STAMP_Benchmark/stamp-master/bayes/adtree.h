@@ -0,0 +1,151 @@
+/* =============================================================================
+ *
+ * adtree.h
+ *
+ * =============================================================================
+ *
+ * Copyright (C) Stanford University, 2006.  All Rights Reserved.
+ * Author: Chi Cao Minh
+ *
+ * =============================================================================
+ *
+ * For the license of bayes/sort.h and bayes/sort.c, please see the header
+ * of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of kmeans, please see kmeans/LICENSE.kmeans
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of ssca2, please see ssca2/COPYRIGHT
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/mt19937ar.c and lib/mt19937ar.h, please see the
+ * header of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/rbtree.h and lib/rbtree.c, please see
+ * lib/LEGALNOTICE.rbtree and lib/LICENSE.rbtree
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * Unless otherwise noted, the following license applies to STAMP files:
+ * 
+ * Copyright (c) 2007, Stanford University
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ * 
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ * 
+ *     * Neither the name of Stanford University nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY STANFORD UNIVERSITY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL STANFORD UNIVERSITY BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * =============================================================================
+ */
+
+
+
+#ifndef ADTREE_H
+#define ADTREE_H 1
+
+
+#include "data.h"
+#include "query.h"
+#include "vector.h"
+
+
+/*
+ * All-dimensions tree [2] caching the number of records matching any query.
+ * Only the counts of the less common value of a variable are stored; the
+ * others are derived by subtraction.
+ */
+typedef struct adtree_node {
+    long index;
+    long value;
+    long count;
+    vector_t* varyVectorPtr;
+} adtree_node_t;
+
+typedef struct adtree_vary {
+    long index;
+    long mostCommonValue;
+    adtree_node_t* zeroNodePtr;
+    adtree_node_t* oneNodePtr;
+} adtree_vary_t;
+
+typedef struct adtree {
+    long numVar;
+    long numRecord;
+    adtree_node_t* rootNodePtr;
+} adtree_t;
+
+
+/* =============================================================================
+ * adtree_alloc
+ * =============================================================================
+ */
+adtree_t*
+adtree_alloc ();
+
+
+/* =============================================================================
+ * adtree_free
+ * =============================================================================
+ */
+void
+adtree_free (adtree_t* adtreePtr);
+
+
+/* =============================================================================
+ * adtree_make
+ * -- Records in dataPtr are sorted as the tree is made
+ * =============================================================================
+ */
+void
+adtree_make (adtree_t* adtreePtr, data_t* dataPtr);
+
+
+/* =============================================================================
+ * adtree_getCount
+ * -- queryVector must be sorted by index, and no value may be a wildcard
+ * -- The values of the queries are restored before returning
+ * =============================================================================
+ */
+long
+adtree_getCount (adtree_t* adtreePtr, vector_t* queryVectorPtr);
+
+
+#endif /* ADTREE_H */
+
+
+/* =============================================================================
+ *
+ * End of adtree.h
+ *
+ * =============================================================================
+ */
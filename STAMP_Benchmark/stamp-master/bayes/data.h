@@ -0,0 +1,161 @@
+/* =============================================================================
+ *
+ * data.h
+ *
+ * =============================================================================
+ *
+ * Copyright (C) Stanford University, 2006.  All Rights Reserved.
+ * Author: Chi Cao Minh
+ *
+ * =============================================================================
+ *
+ * For the license of bayes/sort.h and bayes/sort.c, please see the header
+ * of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of kmeans, please see kmeans/LICENSE.kmeans
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of ssca2, please see ssca2/COPYRIGHT
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/mt19937ar.c and lib/mt19937ar.h, please see the
+ * header of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/rbtree.h and lib/rbtree.c, please see
+ * lib/LEGALNOTICE.rbtree and lib/LICENSE.rbtree
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * Unless otherwise noted, the following license applies to STAMP files:
+ * 
+ * Copyright (c) 2007, Stanford University
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ * 
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ * 
+ *     * Neither the name of Stanford University nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY STANFORD UNIVERSITY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL STANFORD UNIVERSITY BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * =============================================================================
+ */
+
+
+
+#ifndef DATA_H
+#define DATA_H 1
+
+
+#include "net.h"
+#include "random.h"
+
+
+typedef enum data_config {
+    DATA_PRECISION = 100,
+    DATA_INIT      = 2 /* not 0 or 1 */
+} data_config_t;
+
+/*
+ * numRecord records of numVar binary variables, one char per variable
+ */
+typedef struct data {
+    long numVar;
+    long numRecord;
+    char* records;
+    random_t* randomPtr;
+} data_t;
+
+
+/* =============================================================================
+ * data_alloc
+ * =============================================================================
+ */
+data_t*
+data_alloc (long numVar, long numRecord, random_t* randomPtr);
+
+
+/* =============================================================================
+ * data_free
+ * =============================================================================
+ */
+void
+data_free (data_t* dataPtr);
+
+
+/* =============================================================================
+ * data_generate
+ * -- Generates a random Bayesian network and samples the records from it
+ * -- If seed is < 0, the random number generator is not reseeded
+ * -- Returns the network the records were sampled from
+ * =============================================================================
+ */
+net_t*
+data_generate (data_t* dataPtr, long seed, long maxNumParent, long percentParent);
+
+
+/* =============================================================================
+ * data_getRecord
+ * -- Returns NULL if invalid index
+ * =============================================================================
+ */
+char*
+data_getRecord (data_t* dataPtr, long index);
+
+
+/* =============================================================================
+ * data_sort
+ * -- Sorts the records from start to start+num-1 by their variables from
+ *    offset onward
+ * =============================================================================
+ */
+void
+data_sort (data_t* dataPtr, long start, long num, long offset);
+
+
+/* =============================================================================
+ * data_findSplit
+ * -- Call data_sort first with proper start, num, offset
+ * -- Returns number of records whose variable at offset is 0
+ * =============================================================================
+ */
+long
+data_findSplit (data_t* dataPtr, long start, long num, long offset);
+
+
+#endif /* DATA_H */
+
+
+/* =============================================================================
+ *
+ * End of data.h
+ *
+ * =============================================================================
+ */
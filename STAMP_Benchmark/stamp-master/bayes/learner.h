@@ -0,0 +1,150 @@
+/* =============================================================================
+ *
+ * learner.h
+ *
+ * =============================================================================
+ *
+ * Copyright (C) Stanford University, 2006.  All Rights Reserved.
+ * Author: Chi Cao Minh
+ *
+ * =============================================================================
+ *
+ * For the license of bayes/sort.h and bayes/sort.c, please see the header
+ * of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of kmeans, please see kmeans/LICENSE.kmeans
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of ssca2, please see ssca2/COPYRIGHT
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/mt19937ar.c and lib/mt19937ar.h, please see the
+ * header of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/rbtree.h and lib/rbtree.c, please see
+ * lib/LEGALNOTICE.rbtree and lib/LICENSE.rbtree
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * Unless otherwise noted, the following license applies to STAMP files:
+ * 
+ * Copyright (c) 2007, Stanford University
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ * 
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ * 
+ *     * Neither the name of Stanford University nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY STANFORD UNIVERSITY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL STANFORD UNIVERSITY BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * =============================================================================
+ */
+
+
+
+#ifndef LEARNER_H
+#define LEARNER_H 1
+
+
+#include "adtree.h"
+#include "data.h"
+#include "list.h"
+#include "net.h"
+#include "operation.h"
+
+
+typedef struct learner_task {
+    operation_t op;
+    long fromId;
+    long toId;
+    float score;
+} learner_task_t;
+
+/*
+ * netPtr, the log likelihoods, numTotalParent and taskListPtr are shared by
+ * the threads and accessed through the TM interface. tasks[v] holds the one
+ * task for edges into variable v; it is written only by the thread that
+ * took it from the list.
+ */
+typedef struct learner {
+    adtree_t* adtreePtr;
+    net_t* netPtr;
+    float* localBaseLogLikelihoods;
+    float baseLogLikelihood;
+    learner_task_t* tasks;
+    list_t* taskListPtr;
+    long numTotalParent;
+} learner_t;
+
+
+/* =============================================================================
+ * learner_alloc
+ * =============================================================================
+ */
+learner_t*
+learner_alloc (data_t* dataPtr, adtree_t* adtreePtr);
+
+
+/* =============================================================================
+ * learner_free
+ * =============================================================================
+ */
+void
+learner_free (learner_t* learnerPtr);
+
+
+/* =============================================================================
+ * learner_run
+ * -- Call adtree_make before this
+ * =============================================================================
+ */
+void
+learner_run (learner_t* learnerPtr);
+
+
+/* =============================================================================
+ * learner_score
+ * -- Score entire network
+ * =============================================================================
+ */
+float
+learner_score (learner_t* learnerPtr);
+
+
+#endif /* LEARNER_H */
+
+
+/* =============================================================================
+ *
+ * End of learner.h
+ *
+ * =============================================================================
+ */
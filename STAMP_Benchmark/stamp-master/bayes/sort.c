@@ -0,0 +1,216 @@
+/* =============================================================================
+ *
+ * sort.c
+ *
+ * =============================================================================
+ *
+ * Copyright (C) Stanford University, 2006.  All Rights Reserved.
+ * Author: Chi Cao Minh
+ *
+ * =============================================================================
+ *
+ * For the license of bayes/sort.h and bayes/sort.c, please see the header
+ * of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of kmeans, please see kmeans/LICENSE.kmeans
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of ssca2, please see ssca2/COPYRIGHT
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/mt19937ar.c and lib/mt19937ar.h, please see the
+ * header of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/rbtree.h and lib/rbtree.c, please see
+ * lib/LEGALNOTICE.rbtree and lib/LICENSE.rbtree
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * Unless otherwise noted, the following license applies to STAMP files:
+ * 
+ * Copyright (c) 2007, Stanford University
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ * 
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ * 
+ *     * Neither the name of Stanford University nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY STANFORD UNIVERSITY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL STANFORD UNIVERSITY BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * =============================================================================
+ */
+
+
+
+#include "sort.h"
+
+
+/* Ranges at most this long are insertion sorted */
+#define SORT_CUTOFF (8)
+
+
+/* =============================================================================
+ * swap
+ * =============================================================================
+ */
+static void
+swap (char* a, char* b, unsigned long width)
+{
+    if (a != b) {
+        while (width-- > 0) {
+            char tmp = *a;
+            *a++ = *b;
+            *b++ = tmp;
+        }
+    }
+}
+
+
+/* =============================================================================
+ * insertionSort
+ * -- Sorts the elements from lo to hi, both included
+ * =============================================================================
+ */
+static void
+insertionSort (char* lo,
+               char* hi,
+               unsigned long width,
+               int (*compare)(const void*, const void*, long, long),
+               long n,
+               long offset)
+{
+    char* p;
+
+    for (p = lo + width; p <= hi; p += width) {
+        char* q;
+        for (q = p; (q > lo) && (compare((q - width), q, n, offset) > 0); q -= width) {
+            swap((q - width), q, width);
+        }
+    }
+}
+
+
+/* =============================================================================
+ * quickSort
+ * -- Sorts the elements from lo to hi, both included
+ * -- Recurses on the smaller part only, so the depth is logarithmic
+ * =============================================================================
+ */
+static void
+quickSort (char* lo,
+           char* hi,
+           unsigned long width,
+           int (*compare)(const void*, const void*, long, long),
+           long n,
+           long offset)
+{
+    while ((unsigned long)(hi - lo) / width >= SORT_CUTOFF) {
+
+        /* Median of three, moved to lo as the pivot */
+        char* mid = lo + ((unsigned long)(hi - lo) / width / 2) * width;
+        if (compare(lo, mid, n, offset) > 0) {
+            swap(lo, mid, width);
+        }
+        if (compare(lo, hi, n, offset) > 0) {
+            swap(lo, hi, width);
+        }
+        if (compare(mid, hi, n, offset) > 0) {
+            swap(mid, hi, width);
+        }
+        swap(lo, mid, width);
+
+        char* i = lo;
+        char* j = hi + width;
+        while (1) {
+            do {
+                i += width;
+            } while ((i <= hi) && (compare(i, lo, n, offset) < 0));
+            do {
+                j -= width;
+            } while (compare(j, lo, n, offset) > 0);
+            if (i >= j) {
+                break;
+            }
+            swap(i, j, width);
+        }
+        swap(lo, j, width);
+
+        if ((j - lo) < (hi - j)) {
+            if (j > lo) {
+                quickSort(lo, (j - width), width, compare, n, offset);
+            }
+            lo = j + width;
+        } else {
+            if (j < hi) {
+                quickSort((j + width), hi, width, compare, n, offset);
+            }
+            hi = j - width;
+        }
+    }
+
+    if (hi > lo) {
+        insertionSort(lo, hi, width, compare, n, offset);
+    }
+}
+
+
+/* =============================================================================
+ * sort
+ * -- Sorts 'num' elements of 'width' bytes in place
+ * -- 'n' and 'offset' are passed on to 'compare', so that records can be
+ *    ordered by a suffix of their fields
+ * =============================================================================
+ */
+void
+sort (void* base,
+      unsigned long num,
+      unsigned long width,
+      int (*compare)(const void*, const void*, long, long),
+      long n,
+      long offset)
+{
+    if ((num < 2) || (width == 0)) {
+        return;
+    }
+
+    char* lo = (char*)base;
+    char* hi = lo + ((num - 1) * width);
+
+    quickSort(lo, hi, width, compare, n, offset);
+}
+
+
+/* =============================================================================
+ *
+ * End of sort.c
+ *
+ * =============================================================================
+ */
@@ -0,0 +1,36 @@
+# ==============================================================================
+#
+# Defines.common.mk
+#
+# ==============================================================================
+
+
+CFLAGS += -DMAP_USE_RBTREE
+
+PROG := intruder
+
+SRCS += \
+	decoder.c \
+	detector.c \
+	dictionary.c \
+	intruder.c \
+	packet.c \
+	preprocessor.c \
+	stream.c \
+	$(LIB)/list.c \
+	$(LIB)/mt19937ar.c \
+	$(LIB)/pair.c \
+	$(LIB)/queue.c \
+	$(LIB)/random.c \
+	$(LIB)/rbtree.c \
+	$(LIB)/thread.c \
+	$(LIB)/vector.c \
+#
+OBJS := ${SRCS:.c=.o}
+
+
+# ==============================================================================
+#
+# End of Defines.common.mk
+#
+# ==============================================================================
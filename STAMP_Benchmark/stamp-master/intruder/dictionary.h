@@ -0,0 +1,155 @@
+/* =============================================================================
+ *
+ * dictionary.h
+ *
+ * =============================================================================
+ *
+ * Copyright (C) Stanford University, 2006.  All Rights Reserved.
+ * Author: Chi Cao Minh
+ *
+ * =============================================================================
+ *
+ * For the license of bayes/sort.h and bayes/sort.c, please see the header
+ * of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of kmeans, please see kmeans/LICENSE.kmeans
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of ssca2, please see ssca2/COPYRIGHT
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/mt19937ar.c and lib/mt19937ar.h, please see the
+ * header of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/rbtree.h and lib/rbtree.c, please see
+ * lib/LEGALNOTICE.rbtree and lib/LICENSE.rbtree
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * Unless otherwise noted, the following license applies to STAMP files:
+ * 
+ * Copyright (c) 2007, Stanford University
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ * 
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ * 
+ *     * Neither the name of Stanford University nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY STANFORD UNIVERSITY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL STANFORD UNIVERSITY BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * =============================================================================
+ */
+
+
+
+#ifndef DICTIONARY_H
+#define DICTIONARY_H 1
+
+
+#include "types.h"
+#include "vector.h"
+
+
+typedef vector_t dictionary_t;
+
+extern const char* global_defaultSignatures[];
+extern const long global_numDefaultSignature;
+
+
+/* =============================================================================
+ * dictionary_alloc
+ * =============================================================================
+ */
+dictionary_t*
+dictionary_alloc ();
+
+
+/* =============================================================================
+ * Pdictionary_alloc
+ * =============================================================================
+ */
+dictionary_t*
+Pdictionary_alloc ();
+
+
+/* =============================================================================
+ * dictionary_free
+ * =============================================================================
+ */
+void
+dictionary_free (dictionary_t* dictionaryPtr);
+
+
+/* =============================================================================
+ * Pdictionary_free
+ * =============================================================================
+ */
+void
+Pdictionary_free (dictionary_t* dictionaryPtr);
+
+
+/* =============================================================================
+ * dictionary_add
+ * =============================================================================
+ */
+bool_t
+dictionary_add (dictionary_t* dictionaryPtr, char* str);
+
+
+/* =============================================================================
+ * dictionary_get
+ * =============================================================================
+ */
+char*
+dictionary_get (dictionary_t* dictionaryPtr, long i);
+
+
+/* =============================================================================
+ * dictionary_match
+ * =============================================================================
+ */
+char*
+dictionary_match (dictionary_t* dictionaryPtr, char* str);
+
+
+#define PDICTIONARY_ALLOC()             Pdictionary_alloc()
+#define PDICTIONARY_FREE(d)             Pdictionary_free(d)
+
+
+#endif /* DICTIONARY_H */
+
+
+/* =============================================================================
+ *
+ * End of dictionary.h
+ *
+ * =============================================================================
+ */
@@ -0,0 +1,30 @@
+# ==============================================================================
+#
+# Defines.common.mk
+#
+# ==============================================================================
+
+
+LIBS += -lm
+
+PROG := kmeans
+
+SRCS += \
+	cluster.c \
+	common.c \
+	kmeans.c \
+	normal.c \
+	$(LIB)/mt19937ar.c \
+	$(LIB)/random.c \
+	$(LIB)/thread.c \
+#
+OBJS := ${SRCS:.c=.o}
+
+CFLAGS += -DOUTPUT_TO_STDOUT
+
+
+# ==============================================================================
+#
+# End of Defines.common.mk
+#
+# ==============================================================================
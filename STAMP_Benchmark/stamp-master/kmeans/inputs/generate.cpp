@@ -0,0 +1,65 @@
+//  generate.cpp
+//  Writes a kmeans input: n points with d attributes scattered around c random centers
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+//
+//  Usage : generate <n> <d> <c> [seed] > random-n<n>-d<d>-c<c>.txt
+//  The same arguments and seed (default 0) always give the same points.
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Size of the stdout buffer, so that large inputs are written in big blocks.
+ * */
+#define OUTPUT_BUFFER (1 << 20)
+
+/*
+ * Centers lie in [0, CENTER_RANGE) in every attribute, and the points of a
+ * center within SPREAD of it.
+ * */
+#define CENTER_RANGE 1.0
+#define SPREAD 0.1
+
+int main(int argc, char **argv)
+{
+	if(argc < 4 || argc > 5) {
+		fprintf(stderr, "Usage: %s <n> <d> <c> [seed]\n", argv[0]);
+		return 1;
+	}
+	long int numPoint = atol(argv[1]);
+	long int numAttribute = atol(argv[2]);
+	long int numCenter = atol(argv[3]);
+	unsigned long long seed = (argc == 5) ? strtoull(argv[4], NULL, 10) : 0;
+	if(numPoint < 1 || numAttribute < 1 || numCenter < 1) {
+		fprintf(stderr, "Error: the sizes must be positive\n");
+		return 1;
+	}
+
+	static char buffer[OUTPUT_BUFFER];
+	setvbuf(stdout, buffer, _IOFBF, sizeof(buffer));
+
+	/*mt19937_64 gives the same sequence on every platform, unlike the
+	  distributions of <random>, so the values are scaled by hand*/
+	mt19937_64 rng(seed);
+	const double unit = 1.0 / 18446744073709551616.0;
+	vector<double> centers(numCenter * numAttribute);
+	for(long int i = 0;i<numCenter * numAttribute;i++) {
+		centers[i] = CENTER_RANGE * (rng() * unit);
+	}
+	//every point is a line: its id, then its attributes
+	for(long int i = 0;i<numPoint;i++) {
+		long int center = (long int)(rng() % (unsigned long long)numCenter);
+		printf("%li", i + 1);
+		for(long int j = 0;j<numAttribute;j++) {
+			double offset = SPREAD * (2.0 * (rng() * unit) - 1.0);
+			printf(" %f", centers[center * numAttribute + j] + offset);
+		}
+		printf("\n");
+	}
+	return 0;
+}
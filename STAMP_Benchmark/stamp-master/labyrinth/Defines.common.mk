@@ -25,7 +25,16 @@ SRCS += \
 #
 OBJS := ${SRCS:.c=.o}
 
-CFLAGS += -DUSE_EARLY_RELEASE
+# EXPANSION=queue builds the original queue expansion instead of the wavefront,
+# see check-expansion.sh
+EXPANSION ?= wavefront
+ifeq ($(EXPANSION),wavefront)
+CFLAGS += -DUSE_WAVEFRONT_EXPANSION
+endif
+CFLAGS += -DUSE_PATH_TICKETS
+CFLAGS += -DQUEUE_COORDINATE_PAIRS
+#CFLAGS += -DGRID_OBJ_WORDS=1
+#CFLAGS += -DCONTENTION_STATS
 
 
 # ==============================================================================
@@ -0,0 +1,34 @@
+#!/bin/sh
+#
+# Routes one fixed generated maze on a single thread with the wavefront and
+# with the original queue expansion, and checks that both route the same
+# number of paths with the same number of grid points. libtl2 must be built,
+# e.g. by ../run.sh or ./compile.sh.
+#
+#   ./check-expansion.sh              128x128x3 maze, 128 paths, seed 1
+#   ./check-expansion.sh 64 64 5 96 7 x, y, z, paths and seed of the maze
+#
+
+X=${1:-128}; Y=${2:-128}; Z=${3:-3}; N=${4:-128}; SEED=${5:-1}
+MAZE=inputs/check-x$X-y$Y-z$Z-n$N-s$SEED.txt
+
+make -f Makefile.stm generate > /dev/null 2>&1 || exit 1
+inputs/generate $X $Y $Z $N $SEED > $MAZE || exit 1
+
+for expansion in queue wavefront; do
+	rm -f labyrinth *.o
+	make -f Makefile.stm EXPANSION=$expansion > /dev/null 2>&1 || { echo "$expansion: build failed"; exit 1; }
+	./labyrinth -i $MAZE -t 1 > $expansion.out 2>&1 || { echo "$expansion: run failed, see $expansion.out"; exit 1; }
+	grep -E "Paths routed|Path points" $expansion.out > $expansion.paths
+	echo "$expansion: `tr '\n' ' ' < $expansion.paths`"
+done
+
+if cmp -s queue.paths wavefront.paths; then
+	echo "PASSED"
+	status=0
+else
+	echo "FAILED: the expansions route different paths"
+	status=1
+fi
+rm -f queue.out wavefront.out queue.paths wavefront.paths $MAZE
+exit $status
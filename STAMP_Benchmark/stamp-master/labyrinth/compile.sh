@@ -1,9 +1,9 @@
 #!/bin/sh
 
 cd ../../tl2;
-rm libtl2.a stm.o;
-g++ -pthread -std=c++11 -c stm.h stm.cpp;
-ar -cvq libtl2.a stm.o;
+rm libtl2.a stm.o wstm.o;
+g++ -pthread -std=c++14 $STMFLAGS -c stm.cpp wstm.cpp;
+ar -cvq libtl2.a stm.o wstm.o;
 
 cd ../stamp-master/lib;
 rm *.o;
@@ -80,7 +80,7 @@
 #include "vector.h"
 #include <iostream>
 
-const unsigned long CACHE_LINE_SIZE = 32UL;
+const unsigned long CACHE_LINE_SIZE = 64UL;
 
 
 /* =============================================================================
@@ -168,7 +168,7 @@ Pgrid_free (grid_t* gridPtr)
  * =============================================================================
  */
 void
-grid_copy (LTransaction *T, KSFTM *lib, map<long int*, long int> *MAP, grid_t* dstGridPtr, grid_t* srcGridPtr)
+grid_copy (LTransaction *T, KSFTM *lib, AddrMap *MAP, grid_t* dstGridPtr, grid_t* srcGridPtr)
 {
    // assert(srcGridPtr->width  == dstGridPtr->width);
    // assert(srcGridPtr->height == dstGridPtr->height);
@@ -177,36 +177,12 @@ grid_copy (LTransaction *T, KSFTM *lib, map<long int*, long int> *MAP, grid_t* d
     //long n = srcGridPtr->width * srcGridPtr->height * srcGridPtr->depth;
     //memcpy(dstGridPtr->points, srcGridPtr->points, (n * sizeof(long)));
 
-	//mazePtr->gridPtr -> GET the GRID SHARED OBJECT
-	long width = srcGridPtr->width;
-	long height = srcGridPtr->height;
-	long depth = srcGridPtr->depth;
-	
-	for (long z = 0; z < depth; z++) {
-		for (long x = 0; x < width; x++) {
-			for (long y = 0; y < height; y++) {
-				TobIdValPair *tobj_id_val_pair = new TobIdValPair;
-				tobj_id_val_pair->id = MAP->at((long int*)grid_getPointRef(srcGridPtr, x, y, z));
-				if(lib->stmRead(T, tobj_id_val_pair) == ABORTED)
-				{
-					T->g_valid = ABORTED;
-					return;
-				}
-				long int value = tobj_id_val_pair->val;
-				 
-				grid_setPoint(dstGridPtr,x,y,z,value);
-             }
-        }
-    }
-
-/*#ifdef USE_EARLY_RELEASE
-    long* srcPoints = srcGridPtr->points;
-    long i;
-    long i_step = (CACHE_LINE_SIZE / sizeof(srcPoints[0]));
-    for (i = 0; i < n; i+=i_step) {
-        TM_EARLY_RELEASE(srcPoints[i]); /* releases entire line */
-  //  }
-//#endif
+	/* The grid is one region of consecutive tobjs, copied without joining the reader's
+	 * lists of its cells; TMgrid_addPath reads the cells of the path it takes. */
+	long n = srcGridPtr->width * srcGridPtr->height * srcGridPtr->depth;
+	if(lib->stmSnapshot(T, MAP->at(srcGridPtr->points), n, dstGridPtr->points) == ABORTED) {
+		T->g_valid = ABORTED;
+	}
 }
 
 
@@ -326,10 +302,12 @@ grid_addPath (grid_t* gridPtr, vector_t* pointVectorPtr)
 
 /* =============================================================================
  * TMgrid_addPath
+ * -- Returns FALSE, after aborting T, if a cell of the path is already taken;
+ *    an abort of T for any other reason marks T invalid and returns TRUE
  * =============================================================================
  */
-void
-TMgrid_addPath (LTransaction *T, KSFTM *lib, map<long int*, long int> *MAP, TM_ARGDECL  grid_t* gridPtr, vector_t* pointVectorPtr)
+bool_t
+TMgrid_addPath (LTransaction *T, KSFTM *lib, AddrMap *MAP, TM_ARGDECL  grid_t* gridPtr, vector_t* pointVectorPtr)
 {
     long i;
     long n = vector_getSize(pointVectorPtr);
@@ -337,27 +315,27 @@ TMgrid_addPath (LTransaction *T, KSFTM *lib, map<long int*, long int> *MAP, TM_A
     for (i = 1; i < (n-1); i++) {
         long* gridPointPtr = (long*)vector_at(pointVectorPtr, i);
         
-        TobIdValPair *tobj_id_val_pair = new TobIdValPair;
-        tobj_id_val_pair->id = MAP->at(gridPointPtr);
-        if(lib->stmRead(T, tobj_id_val_pair) == ABORTED)
-			T->g_valid = ABORTED;
-			return;
-   
+        long id = MAP->at(gridPointPtr);
+        int word = GRID_POINT_WORD(gridPtr, gridPointPtr);
+        float point;
+        if(lib->stmReadWord(T, id, word, &point) == ABORTED) {
+            T->g_valid = ABORTED;
+            return TRUE;
+        }
+
         //long value = (long)TM_SHARED_READ(*gridPointPtr);
-        long value = (long)tobj_id_val_pair->val;
+        long value = (long)point;
         
         if (value != GRID_POINT_EMPTY) {
-            //TM_RESTART();
-            std::cout<<"Abort bhi hua";
-            T->g_valid = ABORTED;
-            return;
+            /* Another path took the cell after the grid was copied */
+            lib->stmAbort(T);
+            return FALSE;
         }
-        TobIdValPair *tobj_id_val_pair1 = new TobIdValPair;
-        tobj_id_val_pair->id = MAP->at(gridPointPtr);
-        tobj_id_val_pair->val = GRID_POINT_FULL;
-        lib->stmWrite(T, tobj_id_val_pair1); 
+        lib->stmWriteWord(T, id, word, GRID_POINT_FULL);
         //TM_SHARED_WRITE(*gridPointPtr, GRID_POINT_FULL);
     }
+
+    return TRUE;
 }
 
 
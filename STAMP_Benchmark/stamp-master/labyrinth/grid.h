@@ -90,6 +90,17 @@ enum {
     GRID_POINT_EMPTY = -1L
 };
 
+/*
+ * Grid points per KSFTM transaction object: a run of points along x, by
+ * default the 8 longs of a cache line. 1 gives every point its own object.
+ */
+#ifndef GRID_OBJ_WORDS
+#  define GRID_OBJ_WORDS 8
+#endif
+
+/* Word of its transaction object that a grid point is */
+#define GRID_POINT_WORD(gridPtr, pointPtr)  (((pointPtr) - (gridPtr)->points) % GRID_OBJ_WORDS)
+
 
 /* =============================================================================
  * grid_alloc
@@ -128,7 +139,7 @@ Pgrid_free (grid_t* gridPtr);
  * =============================================================================
  */
 void
-grid_copy (LTransaction *T, KSFTM *lib, map<long int*, long int> *MAP, grid_t* dstGridPtr, grid_t* srcGridPtr);
+grid_copy (LTransaction *T, KSFTM *lib, AddrMap *MAP, grid_t* dstGridPtr, grid_t* srcGridPtr);
 
 
 /* =============================================================================
@@ -198,13 +209,15 @@ grid_addPath (grid_t* gridPtr, vector_t* pointVectorPtr);
 
 /* =============================================================================
  * TMgrid_addPath
+ * -- Returns FALSE, after aborting T, if a cell of the path is already taken;
+ *    an abort of T for any other reason marks T invalid and returns TRUE
  * =============================================================================
  */
 TM_CALLABLE
 //void
 //TMgrid_addPath (TM_ARGDECL  grid_t* gridPtr, vector_t* pointVectorPtr);
-void
-TMgrid_addPath (LTransaction *T, KSFTM *lib, map<long int*, long int> *MAP, TM_ARGDECL  grid_t* gridPtr, vector_t* pointVectorPtr);
+bool_t
+TMgrid_addPath (LTransaction *T, KSFTM *lib, AddrMap *MAP, TM_ARGDECL  grid_t* gridPtr, vector_t* pointVectorPtr);
 
 /* =============================================================================
  * grid_print
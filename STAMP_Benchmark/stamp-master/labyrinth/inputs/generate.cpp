@@ -0,0 +1,68 @@
+//  generate.cpp
+//  Writes a labyrinth input: an x*y*z maze grid and n uniformly random source/destination pairs
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+//
+//  Usage : generate <x> <y> <z> <n> [seed] > random-x<x>-y<y>-z<z>-n<n>.txt
+//  The same arguments and seed (default 0) always give the same maze.
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_set>
+
+using namespace std;
+
+/*
+ * Size of the stdout buffer, so that large mazes are written in big blocks.
+ * */
+#define OUTPUT_BUFFER (1 << 20)
+
+int main(int argc, char **argv)
+{
+	if(argc < 5 || argc > 6) {
+		fprintf(stderr, "Usage: %s <x> <y> <z> <n> [seed]\n", argv[0]);
+		return 1;
+	}
+	long int width = atol(argv[1]);
+	long int height = atol(argv[2]);
+	long int depth = atol(argv[3]);
+	long int numPath = atol(argv[4]);
+	unsigned long long seed = (argc == 6) ? strtoull(argv[5], NULL, 10) : 0;
+	if(width < 1 || height < 1 || depth < 1 || numPath < 0) {
+		fprintf(stderr, "Error: the dimensions must be positive\n");
+		return 1;
+	}
+
+	//every source and destination is a different cell
+	long int cells = width * height * depth;
+	if(numPath > cells / 2) {
+		fprintf(stderr, "Error: %li paths need more than the %li cells of the grid\n", numPath, cells);
+		return 1;
+	}
+
+	static char buffer[OUTPUT_BUFFER];
+	setvbuf(stdout, buffer, _IOFBF, sizeof(buffer));
+
+	printf("# Dimensions (x, y, z)\n");
+	printf("d %li %li %li\n", width, height, depth);
+	printf("\n# Paths: Sources (x, y, z) -> Destinations (x, y, z)\n");
+
+	/*mt19937_64 gives the same sequence on every platform, unlike the
+	  distributions of <random>, so the cell is taken modulo the grid size*/
+	mt19937_64 rng(seed);
+	unordered_set<long int> used;
+	used.reserve(2 * numPath);
+	for(long int i = 0;i<numPath;i++) {
+		long int endpoints[2];
+		for(int j = 0;j<2;j++) {
+			do {
+				endpoints[j] = (long int)(rng() % (unsigned long long)cells);
+			} while(!used.insert(endpoints[j]).second);
+		}
+		printf("p %li %li %li  %li %li %li\n",
+			endpoints[0] % width, endpoints[0] / width % height, endpoints[0] / (width * height),
+			endpoints[1] % width, endpoints[1] / width % height, endpoints[1] / (width * height));
+	}
+	return 0;
+}
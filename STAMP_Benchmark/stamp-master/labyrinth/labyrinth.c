@@ -80,7 +80,7 @@
 #include "timer.h"
 #include "types.h"
 #include <iostream>
-map<long int*, long int> *MAP;
+AddrMap *MAP;
 //Create an instance of KSFTM here.
 	KSFTM *lib;
 
@@ -193,7 +193,7 @@ parseArgs (long argc, char* const argv[])
  */
 MAIN(argc, argv)
 {
-	MAP = new map<long int*, long int>();
+	MAP = new AddrMap();
 	
     GOTO_REAL();
 
@@ -222,11 +222,11 @@ MAIN(argc, argv)
 	long int k = 0;
 	
 	// workQueuePtr -> QUEUE first SHARED OBJECT.
-	MAP->insert(std::pair<long int*, long int>((long int*)&(mazePtr->workQueuePtr->pop), k));
+	MAP->insert((long int*)&(mazePtr->workQueuePtr->pop), k);
 	k++;
-	MAP->insert(std::pair<long int*, long int>((long int*)&(mazePtr->workQueuePtr->push), k));
+	MAP->insert((long int*)&(mazePtr->workQueuePtr->push), k);
 	k++;
-	MAP->insert(std::pair<long int*, long int>((long int*)&(mazePtr->workQueuePtr->capacity), k));
+	MAP->insert((long int*)&(mazePtr->workQueuePtr->capacity), k);
 	k++;
 	
 	//cout<<((coordinate_t*)(((pair_t*)(mazePtr->workQueuePtr->elements[0]))->secondPtr))->x<<endl;
@@ -236,17 +236,17 @@ MAIN(argc, argv)
 	
 	for(long int i=0;i<mazePtr->workQueuePtr->push;i++)
 	{
-		MAP->insert(std::pair<long int*, long int>((long int*)&(((coordinate_t*)(((pair_t*)(mazePtr->workQueuePtr->elements[i]))->firstPtr))->x), k));
+		MAP->insert((long int*)&(((coordinate_t*)(((pair_t*)(mazePtr->workQueuePtr->elements[i]))->firstPtr))->x), k);
 		k++;
-		MAP->insert(std::pair<long int*, long int>((long int*)&(((coordinate_t*)(((pair_t*)(mazePtr->workQueuePtr->elements[i]))->firstPtr))->y), k));
+		MAP->insert((long int*)&(((coordinate_t*)(((pair_t*)(mazePtr->workQueuePtr->elements[i]))->firstPtr))->y), k);
 		k++;
-		MAP->insert(std::pair<long int*, long int>((long int*)&(((coordinate_t*)(((pair_t*)(mazePtr->workQueuePtr->elements[i]))->firstPtr))->z), k));
+		MAP->insert((long int*)&(((coordinate_t*)(((pair_t*)(mazePtr->workQueuePtr->elements[i]))->firstPtr))->z), k);
 		k++;
-		MAP->insert(std::pair<long int*, long int>((long int*)&(((coordinate_t*)(((pair_t*)(mazePtr->workQueuePtr->elements[i]))->secondPtr))->x), k));
+		MAP->insert((long int*)&(((coordinate_t*)(((pair_t*)(mazePtr->workQueuePtr->elements[i]))->secondPtr))->x), k);
 		k++;
-		MAP->insert(std::pair<long int*, long int>((long int*)&(((coordinate_t*)(((pair_t*)(mazePtr->workQueuePtr->elements[i]))->secondPtr))->y), k));
+		MAP->insert((long int*)&(((coordinate_t*)(((pair_t*)(mazePtr->workQueuePtr->elements[i]))->secondPtr))->y), k);
 		k++;
-		MAP->insert(std::pair<long int*, long int>((long int*)&(((coordinate_t*)(((pair_t*)(mazePtr->workQueuePtr->elements[i]))->secondPtr))->z), k));
+		MAP->insert((long int*)&(((coordinate_t*)(((pair_t*)(mazePtr->workQueuePtr->elements[i]))->secondPtr))->z), k);
 		k++;
 	}
 	
@@ -255,15 +255,13 @@ MAIN(argc, argv)
 	long width = mazePtr->gridPtr->width;
 	long height = mazePtr->gridPtr->height;
 	long depth = mazePtr->gridPtr->depth;
+	long gridBase = k;
 	
-	for (long z = 0; z < depth; z++) {
-		for (long x = 0; x < width; x++) {
-			for (long y = 0; y < height; y++) {
-                MAP->insert(std::pair<long int*, long int>((long int*)grid_getPointRef(mazePtr->gridPtr, x, y, z), k));
-                k++;
-            }
-        }
-    }
+	/* The grid points are one array, registered as a region so that their ids are found by arithmetic.
+	   A transaction object holds GRID_OBJ_WORDS consecutive points.*/
+	long numGridObjs = (width * height * depth + GRID_OBJ_WORDS - 1) / GRID_OBJ_WORDS;
+	MAP->addRegion(mazePtr->gridPtr->points, numGridObjs, GRID_OBJ_WORDS * sizeof(long), k);
+	k += numGridObjs;
 	
 	//pathVectorListPtr : Get the shared list size equal to the number of threads.(numThread)
 	for(int i=0;i<numThread;i++)
@@ -273,23 +271,21 @@ MAIN(argc, argv)
 	}
 	
 	// Get the total path insert shared variable. As numPathRouted.
-	long *tm_numPathRouted;
-	MAP->insert(std::pair<long int*, long int>(tm_numPathRouted, k));
+	long *tm_numPathRouted = new long(0);
+	MAP->insert(tm_numPathRouted, k);
 	
-	// Initialize KSFTM instance.
-	lib = new KSFTM(k+1);
+	// Initialize KSFTM instance, its tobjs placed as $STM_PLACEMENT says.
+	lib = new KSFTM(k+1, placementFromEnv(PLACE_FIRST_TOUCH));
+	lib->setWords(gridBase, numGridObjs, GRID_OBJ_WORDS);
+	//the grid points go straight into the objects' first versions, in id order
+	lib->initWords(gridBase, mazePtr->gridPtr->points, width * height * depth);
 	
 
 	// INITIALIZE THE DATA VALUES IN THE KSFTM'S INSTANCE.
-	LTransaction* T1 = new LTransaction;
-	T1->g_its = NIL;
+	// The initialization transaction runs irrevocably, it is never aborted and re-executed.
+	LTransaction* T1;
 	while(true) {
-		if(T1->g_its != NIL) {
-			long int its = T1->g_its;
-			T1 = lib->tbegin(its);
-		} else {
-			T1 = lib->tbegin(T1->g_its);
-		}
+		T1 = lib->tbeginIrrevocable();
 		
 		TobIdValPair *tobj_id_val_pair = new TobIdValPair;
 		tobj_id_val_pair->id = MAP->at(&(mazePtr->workQueuePtr->push));
@@ -346,19 +342,6 @@ MAIN(argc, argv)
 			
 		}
 		
-		for (long z = 0; z < depth; z++) {
-			for (long x = 0; x < width; x++) {
-				for (long y = 0; y < height; y++) {
-					//MAP->insert(std::pair<long int*, long int>(grid_getPointRef(mazePtr->gridPtr, x, y, z), k));
-					TobIdValPair *tobj_id_val_pair = new TobIdValPair;
-					tobj_id_val_pair->id = MAP->at(grid_getPointRef(mazePtr->gridPtr, x, y, z));
-					tobj_id_val_pair->val = *grid_getPointRef(mazePtr->gridPtr, x, y, z);
-					lib->stmWrite(T1, tobj_id_val_pair);
-				}
-			}
-		}	
-		
-		
 		/* Try to commit the current transaction. If stmTryCommit returns ABORTED then retry this transaction again. */
 		if(lib->stmTryCommit(T1) == ABORTED) {
 			continue;
@@ -373,9 +356,14 @@ MAIN(argc, argv)
      * Run transactions
      */
     router_solve_arg_t routerArg = {lib, MAP, routerPtr, mazePtr, pathVectorListPtr, tm_numPathRouted};
+    queue_t* workQueuePtr = mazePtr->workQueuePtr;
+    routerArg.firstPath = workQueuePtr->pop + 1;
+    routerArg.numPath = (workQueuePtr->push - workQueuePtr->pop - 1 + workQueuePtr->capacity) % workQueuePtr->capacity;
+    routerArg.nextPath.store(0);
     
    
     
+    NumaCounters numaBefore;
     TIMER_T startTime;
     TIMER_READ(startTime);
     GOTO_SIM();
@@ -390,18 +378,9 @@ MAIN(argc, argv)
     GOTO_REAL();
     TIMER_T stopTime;
     TIMER_READ(stopTime);
+    NumaCounters numaAfter;
 
 
-	 float max_time = 0.0;
-	 float timeTotal = 0.0;
-    
-    for(int i=0;i<numThread;i++)
-    {
-		if(routerArg.time[i] > max_time)
-		 max_time = routerArg.time[i];
-		 timeTotal += routerArg.totalTime[thread_getId()];
-	}
-	
     long numPathRouted = 0;
     /*list_iter_t it;
     list_iter_reset(&it, pathVectorListPtr);
@@ -410,35 +389,23 @@ MAIN(argc, argv)
         numPathRouted += vector_getSize(pathVectorPtr);
     }*/
     
-    LTransaction* T = new LTransaction;
-	T->g_its = NIL;
-	
-	label: while(true) {
-		if(T->g_its != NIL) {
-			long int its = T->g_its;
-			T = lib->tbegin(its);
-		} else {
-			T = lib->tbegin(T->g_its);
-		}
-		
-		TobIdValPair *tobj_id_val_pair = new TobIdValPair;
-		tobj_id_val_pair->id = MAP->at(tm_numPathRouted);
-		if(lib->stmRead(T, tobj_id_val_pair) == ABORTED)
-		{
-			goto label;
-		}
-		numPathRouted = tobj_id_val_pair->val;
-
-		/* Try to commit the current transaction. If stmTryCommit returns ABORTED then retry this transaction again. */
-		if(lib->stmTryCommit(T) == ABORTED) {
-			continue;
-		}
-		// Break out of the while loop since the transaction has committed
-		break;
-	}
+    TM_BEGIN(T, lib);
+    TobIdValPair *tobj_id_val_pair = new TobIdValPair;
+    tobj_id_val_pair->id = MAP->at(tm_numPathRouted);
+    lib->stmRead(T, tobj_id_val_pair);
+    numPathRouted = tobj_id_val_pair->val;
+    TM_END(T, lib);
     
+    long numPathPoints = 0;
+    for (long t = 0; t < numThread; t++) {
+        numPathPoints += routerArg.phases[t].points;
+    }
     printf("Paths routed    = %li\n", numPathRouted);
-    printf("Elapsed time    = %f seconds, Worst Maximum Time = %f : Average Time = %f\n", TIMER_DIFF_SECONDS(startTime, stopTime),max_time,timeTotal/numThread);
+    printf("Path points     = %li\n", numPathPoints);
+    printf("Elapsed time    = %f seconds\n", TIMER_DIFF_SECONDS(startTime, stopTime));
+    router_reportPhases(&routerArg, numThread);
+    lib->reportOutcomes();
+    numaAfter.report(numaBefore);
 
     /*
      * Check solution and clean up
@@ -447,6 +414,14 @@ MAIN(argc, argv)
     bool_t status = maze_checkPaths(mazePtr, pathVectorListPtr, global_doPrint);
     assert(status == TRUE);
     puts("Verification passed.");
+
+#ifdef CONTENTION_STATS
+    /* Hot object report; libtl2 must be built with STMFLAGS=-DCONTENTION_STATS */
+    printf("Object ids: 0-2 = queue pop/push/capacity, 3-%li = work coordinates, "
+           "%li-%li = grid tiles of %i cells, %li = numPathRouted\n",
+           gridBase - 1, gridBase, k - 1, GRID_OBJ_WORDS, k);
+    lib->reportContention(20);
+#endif
     maze_free(mazePtr);
     router_free(routerPtr);
 
@@ -70,7 +70,12 @@
 
 
 #include <assert.h>
+#include <fcntl.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "coordinate.h"
 #include "grid.h"
 #include "list.h"
@@ -149,19 +154,65 @@ addToGrid (grid_t* gridPtr, vector_t* vectorPtr, char* type)
 }
 
 
+/* =============================================================================
+ * parseLong
+ * -- Parses the next decimal integer before 'end', skipping blanks; the
+ *    counterpart of sscanf's %li for the maze format
+ * =============================================================================
+ */
+static bool_t
+parseLong (const char** textPtr, const char* end, long* valuePtr)
+{
+    const char* p = *textPtr;
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+    bool_t isNegative = FALSE;
+    if (p < end && (*p == '-' || *p == '+')) {
+        isNegative = (*p == '-');
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9') {
+        return FALSE;
+    }
+    long value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p - '0');
+        p++;
+    }
+    *valuePtr = (isNegative ? -value : value);
+    *textPtr = p;
+    return TRUE;
+}
+
+
 /* =============================================================================
  * maze_read
  * -- Return number of path to route
+ * -- The input is mapped into memory and parsed in place, so large mazes do
+ *    not pay for a read and a sscanf per line
  * =============================================================================
  */
 long
 maze_read (maze_t* mazePtr, char* inputFileName)
 {
-    FILE* inputFile = fopen(inputFileName, "rt");
-    if (!inputFile) {
+    int inputFile = open(inputFileName, O_RDONLY);
+    struct stat inputStat;
+    if (inputFile < 0 || fstat(inputFile, &inputStat) != 0) {
         fprintf(stderr, "Error: Could not read %s\n", inputFileName);
         exit(1);
     }
+    const char* text = NULL;
+    if (inputStat.st_size > 0) {
+        void* mapPtr = mmap(NULL, inputStat.st_size, PROT_READ, MAP_PRIVATE, inputFile, 0);
+        if (mapPtr == MAP_FAILED) {
+            fprintf(stderr, "Error: Could not map %s\n", inputFileName);
+            exit(1);
+        }
+        madvise(mapPtr, inputStat.st_size, MADV_SEQUENTIAL);
+        text = (const char*)mapPtr;
+    }
+    const char* textEnd = text + inputStat.st_size;
 
     /*
      * Parse input file
@@ -170,25 +221,37 @@ maze_read (maze_t* mazePtr, char* inputFileName)
     long height = -1;
     long width  = -1;
     long depth  = -1;
-    char line[256];
     list_t* workListPtr = list_alloc(&coordinate_comparePair);
     vector_t* wallVectorPtr = mazePtr->wallVectorPtr;
     vector_t* srcVectorPtr = mazePtr->srcVectorPtr;
     vector_t* dstVectorPtr = mazePtr->dstVectorPtr;
 
-    while (fgets(line, sizeof(line), inputFile)) {
+    const char* line = text;
+    while (line < textEnd) {
 
-        char code;
-        long x1, y1, z1;
-        long x2, y2, z2;
-        long numToken = sscanf(line, " %c %li %li %li %li %li %li",
-                              &code, &x1, &y1, &z1, &x2, &y2, &z2);
+        const char* lineEnd = (const char*)memchr(line, '\n', textEnd - line);
+        if (!lineEnd) {
+            lineEnd = textEnd;
+        }
+        const char* p = line;
+        line = lineEnd + 1;
 
         lineNumber++;
 
-        if (numToken < 1) {
+        while (p < lineEnd && (*p == ' ' || *p == '\t' || *p == '\r')) {
+            p++;
+        }
+        if (p == lineEnd) {
             continue;
         }
+        char code = *p++;
+        long values[6] = {0, 0, 0, 0, 0, 0};
+        long numToken = 1;
+        while (numToken < 7 && parseLong(&p, lineEnd, &values[numToken-1])) {
+            numToken++;
+        }
+        long x1 = values[0], y1 = values[1], z1 = values[2];
+        long x2 = values[3], y2 = values[4], z2 = values[5];
 
         switch (code) {
             case '#': { /* comment */
@@ -244,6 +307,11 @@ maze_read (maze_t* mazePtr, char* inputFileName)
 
     } /* iterate over lines in input file */
 
+    if (text) {
+        munmap((void*)text, inputStat.st_size);
+    }
+    close(inputFile);
+
     /*
      * Initialize grid contents
      */
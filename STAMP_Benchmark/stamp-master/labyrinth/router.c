@@ -77,7 +77,9 @@
 #include "router.h"
 #include "vector.h"
 #include "timer.h"
-#include <sys/time.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
 
 
 typedef enum momentum {
@@ -163,6 +165,189 @@ PexpandToNeighbor (grid_t* myGridPtr,
 }
 
 
+#ifdef USE_WAVEFRONT_EXPANSION
+/* =============================================================================
+ * Wavefront expansion
+ *
+ * Expands the source a cost level at a time over bitsets, one bit per cell
+ * and a row (fixed y and z) per WAVE_WORDS words, so 64 cells are handled
+ * by every word operation. The cells reached at level L are the cells next
+ * to the frontier of level L - xCost in x, of level L - yCost in y and of
+ * level L - zCost in z that are neither full nor reached before; frontiers
+ * are kept in a ring of maxCost + 1 levels, each with the list of its non
+ * empty rows and their non empty words, so a level only touches the words
+ * next to the last frontiers.
+ * The expansion stops after the level that reaches the destination.
+ *
+ * A reached cell gets its level, which is its exact cost: every reached cell
+ * has a neighbour cheaper by the step cost, as the queue based expansion
+ * leaves them, so PdoTraceback walks the result in the same way.
+ * =============================================================================
+ */
+typedef unsigned long long wave_word_t;
+
+/* Row of a frontier and the range of its words that may be non zero */
+typedef struct wave_span {
+    long row;
+    long lo;
+    long hi;
+} wave_span_t;
+
+static thread_local std::vector<wave_word_t> waveOpen;
+static thread_local std::vector<wave_word_t> waveSeen;
+static thread_local std::vector<wave_word_t> waveFront;
+static thread_local std::vector< std::vector<wave_span_t> > waveSpans;
+static thread_local std::vector<wave_span_t> waveCand;
+static thread_local std::vector<long> waveCandOf;
+
+/* Adds words lo..hi of 'row' to the rows 'cand' the current level grows into */
+static inline void
+PwaveCandidate (std::vector<wave_span_t>& cand, long* candOf, long row, long lo, long hi)
+{
+    long c = candOf[row];
+    if (c < 0) {
+        candOf[row] = cand.size();
+        wave_span_t span = {row, lo, hi};
+        cand.push_back(span);
+    } else {
+        cand[c].lo = std::min(cand[c].lo, lo);
+        cand[c].hi = std::max(cand[c].hi, hi);
+    }
+}
+
+static bool_t
+PdoWavefrontExpansion (router_t* routerPtr, grid_t* myGridPtr,
+                       coordinate_t* srcPtr, coordinate_t* dstPtr)
+{
+    long width = myGridPtr->width;
+    long height = myGridPtr->height;
+    long depth = myGridPtr->depth;
+    long numRow = height * depth;
+    long words = (width + 63) / 64;
+    long cost[3] = {routerPtr->xCost, routerPtr->yCost, routerPtr->zCost};
+    long ring = std::max(cost[0], std::max(cost[1], cost[2])) + 1;
+    long* points = myGridPtr->points;
+
+    waveOpen.assign(numRow * words, 0);
+    waveSeen.assign(numRow * words, 0);
+    waveFront.assign(ring * numRow * words, 0);
+    waveSpans.assign(ring, std::vector<wave_span_t>());
+    waveCandOf.assign(numRow, -1);
+    /* the thread local buffers are reached through plain pointers from here on */
+    wave_word_t* openBits = &waveOpen[0];
+    wave_word_t* seenBits = &waveSeen[0];
+    wave_word_t* frontBits = &waveFront[0];
+    std::vector< std::vector<wave_span_t> >& allSpans = waveSpans;
+    std::vector<wave_span_t>& cand = waveCand;
+    long* candOf = &waveCandOf[0];
+    for (long row = 0; row < numRow; row++) {
+        for (long x = 0; x < width; x++) {
+            openBits[row * words + (x >> 6)] |= (wave_word_t)(points[row * width + x] == GRID_POINT_EMPTY) << (x & 63);
+        }
+    }
+    long srcRow = srcPtr->z * height + srcPtr->y;
+    long dstRow = dstPtr->z * height + dstPtr->y;
+    wave_word_t dstBit = 1ULL << (dstPtr->x & 63);
+    wave_word_t* dstSeen = &seenBits[dstRow * words + (dstPtr->x >> 6)];
+    openBits[dstRow * words + (dstPtr->x >> 6)] |= dstBit;
+    seenBits[srcRow * words + (srcPtr->x >> 6)] |= 1ULL << (srcPtr->x & 63);
+    frontBits[srcRow * words + (srcPtr->x >> 6)] = 1ULL << (srcPtr->x & 63);
+    wave_span_t srcSpan = {srcRow, srcPtr->x >> 6, srcPtr->x >> 6};
+    allSpans[0].push_back(srcSpan);
+    grid_setPoint(myGridPtr, srcPtr->x, srcPtr->y, srcPtr->z, 0);
+
+    long idle = 0;
+    for (long level = 1; !(*dstSeen & dstBit); level++) {
+        if (idle == ring) {
+            return FALSE; /* every frontier in the ring is empty */
+        }
+        long slot = level % ring;
+        wave_word_t* front = frontBits + slot * numRow * words;
+        std::vector<wave_span_t>& spans = allSpans[slot];
+        for (long i = 0; i < (long)spans.size(); i++) {
+            memset(front + spans[i].row * words + spans[i].lo, 0,
+                   (spans[i].hi - spans[i].lo + 1) * sizeof(wave_word_t));
+        }
+        spans.clear();
+
+        /* rows and words next to the frontiers this level grows from */
+        const wave_word_t* from[3] = {NULL, NULL, NULL};
+        for (long d = 0; d < 3; d++) {
+            if (level < cost[d]) {
+                continue;
+            }
+            long fromSlot = (level - cost[d]) % ring;
+            from[d] = frontBits + fromSlot * numRow * words;
+            std::vector<wave_span_t>& fromSpans = allSpans[fromSlot];
+            for (long i = 0; i < (long)fromSpans.size(); i++) {
+                long r = fromSpans[i].row;
+                long lo = fromSpans[i].lo;
+                long hi = fromSpans[i].hi;
+                if (d == 0) {
+                    PwaveCandidate(cand, candOf, r, std::max(lo - 1, 0L), std::min(hi + 1, words - 1));
+                } else if (d == 1) {
+                    long y = r % height;
+                    if (y > 0)          PwaveCandidate(cand, candOf, r - 1, lo, hi);
+                    if (y < height - 1) PwaveCandidate(cand, candOf, r + 1, lo, hi);
+                } else {
+                    if (r >= height)         PwaveCandidate(cand, candOf, r - height, lo, hi);
+                    if (r + height < numRow) PwaveCandidate(cand, candOf, r + height, lo, hi);
+                }
+            }
+        }
+
+        for (long i = 0; i < (long)cand.size(); i++) {
+            long r = cand[i].row;
+            long lo = cand[i].lo;
+            long hi = cand[i].hi;
+            candOf[r] = -1;
+            long y = r % height;
+            wave_word_t* next = front + r * words;
+            const wave_word_t* open = openBits + r * words;
+            wave_word_t* seen = seenBits + r * words;
+            const wave_word_t* fx = from[0] ? from[0] + r * words : NULL;
+            const wave_word_t* fyLow = (from[1] && y > 0) ? from[1] + (r - 1) * words : NULL;
+            const wave_word_t* fyHigh = (from[1] && y < height - 1) ? from[1] + (r + 1) * words : NULL;
+            const wave_word_t* fzLow = (from[2] && r >= height) ? from[2] + (r - height) * words : NULL;
+            const wave_word_t* fzHigh = (from[2] && r + height < numRow) ? from[2] + (r + height) * words : NULL;
+            long newLo = words;
+            long newHi = -1;
+            for (long w = lo; w <= hi; w++) {
+                wave_word_t bits = 0;
+                if (fx) {
+                    bits |= (fx[w] << 1) | (fx[w] >> 1);
+                    if (w > 0)         bits |= fx[w - 1] >> 63;
+                    if (w < words - 1) bits |= fx[w + 1] << 63;
+                }
+                if (fyLow)  bits |= fyLow[w];
+                if (fyHigh) bits |= fyHigh[w];
+                if (fzLow)  bits |= fzLow[w];
+                if (fzHigh) bits |= fzHigh[w];
+                bits &= open[w] & ~seen[w];
+                if (bits) {
+                    next[w] = bits;
+                    seen[w] |= bits;
+                    newLo = std::min(newLo, w);
+                    newHi = w;
+                    for (wave_word_t b = bits; b; b &= b - 1) {
+                        points[r * width + w * 64 + __builtin_ctzll(b)] = level;
+                    }
+                }
+            }
+            if (newHi >= 0) {
+                wave_span_t span = {r, newLo, newHi};
+                spans.push_back(span);
+            }
+        }
+        cand.clear();
+        idle = spans.empty() ? idle + 1 : 0;
+    }
+
+    return TRUE;
+}
+#endif /* USE_WAVEFRONT_EXPANSION */
+
+
 /* =============================================================================
  * PdoExpansion
  * =============================================================================
@@ -175,6 +360,10 @@ PdoExpansion (router_t* routerPtr, grid_t* myGridPtr, queue_t* queuePtr,
     long yCost = routerPtr->yCost;
     long zCost = routerPtr->zCost;
 
+#ifdef USE_WAVEFRONT_EXPANSION
+    return PdoWavefrontExpansion(routerPtr, myGridPtr, srcPtr, dstPtr);
+#endif
+
     /*
      * Potential Optimization: Make 'src' the one closest to edge.
      * This will likely decrease the area of the emitted wave.
@@ -266,14 +455,15 @@ traceToNeighbor (grid_t* myGridPtr,
 
 
 /* =============================================================================
- * PdoTraceback
+ * TMdoTraceback
+ * -- The path vector is allocated inside T, it is reclaimed if T aborts
  * =============================================================================
  */
 static vector_t*
-PdoTraceback (grid_t* gridPtr, grid_t* myGridPtr,
+TMdoTraceback (LTransaction *T, KSFTM *lib, grid_t* gridPtr, grid_t* myGridPtr,
               coordinate_t* dstPtr, long bendCost)
 {
-    vector_t* pointVectorPtr = PVECTOR_ALLOC(1);
+    vector_t* pointVectorPtr = TMVECTOR_ALLOC(T, lib, 1);
     assert(pointVectorPtr);
 
     point_t next;
@@ -286,7 +476,7 @@ PdoTraceback (grid_t* gridPtr, grid_t* myGridPtr,
     while (1) {
 
         long* gridPointPtr = grid_getPointRef(gridPtr, next.x, next.y, next.z);
-        PVECTOR_PUSHBACK(pointVectorPtr, (void*)gridPointPtr);
+        TMVECTOR_PUSHBACK(T, lib, pointVectorPtr, (void*)gridPointPtr);
         grid_setPoint(myGridPtr, next.x, next.y, next.z, GRID_POINT_FULL);
 
         /* Check if we are done */
@@ -330,7 +520,7 @@ PdoTraceback (grid_t* gridPtr, grid_t* myGridPtr,
                 (curr.y == next.y) &&
                 (curr.z == next.z))
             {
-                PVECTOR_FREE(pointVectorPtr);
+                TMVECTOR_FREE(T, lib, pointVectorPtr);
 //#if DEBUG
                 puts("[dead]");
 //#endif
@@ -347,14 +537,70 @@ PdoTraceback (grid_t* gridPtr, grid_t* myGridPtr,
 }
 
 
-// Method that return time in seconds.
-double timeRequest() {
-  struct timeval tp;
-  gettimeofday(&tp, NULL);
-  double timevalue = tp.tv_sec + (tp.tv_usec/1000000.0);
-  return timevalue;
+/* =============================================================================
+ * phaseNow
+ * -- steady_clock time in nanoseconds
+ * =============================================================================
+ */
+static inline long
+phaseNow ()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/* =============================================================================
+ * phaseEnd
+ * -- Adds the time of the running phase, if any, to its totals
+ * =============================================================================
+ */
+static void
+phaseEnd (router_phase_stats_t* statsPtr, bool_t isAborted)
+{
+    long phase = statsPtr->current;
+    if (phase == PHASE_NONE) {
+        return;
+    }
+    long ns = phaseNow() - statsPtr->since;
+    statsPtr->ns[phase] += ns;
+    statsPtr->maxNs[phase] = std::max(statsPtr->maxNs[phase], ns);
+    if (isAborted) {
+        statsPtr->retries[phase]++;
+    } else {
+        statsPtr->count[phase]++;
+    }
+    statsPtr->current = PHASE_NONE;
+}
+
+
+/* =============================================================================
+ * phaseBegin
+ * -- Ends the running phase and starts 'phase'
+ * =============================================================================
+ */
+static void
+phaseBegin (router_phase_stats_t* statsPtr, long phase)
+{
+    phaseEnd(statsPtr, FALSE);
+    statsPtr->current = phase;
+    statsPtr->since = phaseNow();
+}
+
+
+/* =============================================================================
+ * phaseRestart
+ * -- Called right after TM_BEGIN: a phase still running there was cut short
+ *    by an abort, which counts as a retry of it
+ * =============================================================================
+ */
+static void
+phaseRestart (router_phase_stats_t* statsPtr)
+{
+    phaseEnd(statsPtr, TRUE);
 }
 
+
 /* =============================================================================
  * router_solve
  * =============================================================================
@@ -362,21 +608,15 @@ double timeRequest() {
 void
 router_solve (void* argPtr)
 {
-	double startTime, endTime;
-	double startTimeTotal, endTimeTotal;
-	
-	int tx = 0;
-	
-	startTimeTotal = timeRequest();
-	
     TM_THREAD_ENTER();
     router_solve_arg_t* routerArgPtr = (router_solve_arg_t*)argPtr;
     router_t* routerPtr = routerArgPtr->routerPtr;
     maze_t* mazePtr = routerArgPtr->mazePtr;
     vector_t* myPathVectorPtr = PVECTOR_ALLOC(1);
     assert(myPathVectorPtr);
-		
-	routerArgPtr->time[thread_getId()] = 0.0;
+
+    router_phase_stats_t* statsPtr = &routerArgPtr->phases[thread_getId()];
+    statsPtr->current = PHASE_NONE;
 
     queue_t* workQueuePtr = mazePtr->workQueuePtr;
     grid_t* gridPtr = mazePtr->gridPtr;
@@ -387,7 +627,7 @@ router_solve (void* argPtr)
     queue_t* myExpansionQueuePtr = PQUEUE_ALLOC(-1);
 
 	KSFTM *lib = routerArgPtr->lib;
-	map<long int*, long int> *MAP = routerArgPtr->MAP;
+	AddrMap *MAP = routerArgPtr->MAP;
 	
 	long *tm_numPathRouted = routerArgPtr->tm_numPathRouted;
     
@@ -401,185 +641,109 @@ router_solve (void* argPtr)
      * 'expansion' and 'traceback' phase for each source/destination pair.
      */
     while (1) {
-int count=0;
         pair_t* coordinatePairPtr;
-        //TM_BEGIN();
-        
-        //std::cout<<"Create a new transaction"<<endl;
-        
-        LTransaction* T1 = new LTransaction();
-        startTime = timeRequest();
-		T1->g_its = NIL;
-		
-		label1: while(true) {
-			if(T1->g_its != NIL) {
-				long int its = T1->g_its;
-				T1 = lib->tbegin(its);
-				tx++;
-			} else {
-				T1 = lib->tbegin(T1->g_its);
-				tx++;
-			}
-
-			bool queueEmpty = TMQUEUE_ISEMPTY(T1, lib, MAP, workQueuePtr);	
-			
-					
-			if (T1->g_valid == ABORTED) {
-				goto label1;
-			} else if(queueEmpty == true)
-			{
-				coordinatePairPtr = NULL;
-			} else {
-				
-				coordinatePairPtr = (pair_t*)TMQUEUE_POP(T1, lib, MAP, workQueuePtr);
-				
-				if(T1->g_valid == ABORTED)
-				{
-					goto label1;
-				}
-				TobIdValPair *tobj_id_val_pair1 = new TobIdValPair;
-				tobj_id_val_pair1->id = MAP->at(&(workQueuePtr->pop));
-				if(lib->stmRead(T1, tobj_id_val_pair1) == ABORTED)
-				{
-					goto label1;
-				}
-				
-			}
-			
-			//TM_END();
-			/* Try to commit the current transaction. If stmTryCommit returns ABORTED then retry this transaction again. */
-			if(lib->stmTryCommit(T1) == ABORTED) {
-				continue;
-			}
-			
-			endTime = timeRequest();
-			// Break out of the while loop since the transaction has committed
-			if(routerArgPtr->time[thread_getId()] < (endTime-startTime))
-				routerArgPtr->time[thread_getId()] = (endTime-startTime);
-			break;
-		}
-		
+#ifdef USE_PATH_TICKETS
+        phaseBegin(statsPtr, PHASE_POP);
+        long ticket = routerArgPtr->nextPath.fetch_add(1, std::memory_order_relaxed);
+        if (ticket >= routerArgPtr->numPath) {
+            phaseEnd(statsPtr, FALSE);
+            break;
+        }
+        /* The coordinates are never written after the initialization transaction */
+        coordinatePairPtr = (pair_t*)workQueuePtr->elements[(routerArgPtr->firstPath + ticket) % workQueuePtr->capacity];
+#else
+        /* An abort anywhere in the transaction jumps back to TM_BEGIN */
+        TM_BEGIN(T1, lib);
+        phaseRestart(statsPtr);
+        phaseBegin(statsPtr, PHASE_POP);
+
+        if (TMQUEUE_ISEMPTY(T1, lib, MAP, workQueuePtr)) {
+            coordinatePairPtr = NULL;
+        } else {
+            coordinatePairPtr = (pair_t*)TMQUEUE_POP(T1, lib, MAP, workQueuePtr);
+            TobIdValPair *tobj_id_val_pair1 = new TobIdValPair;
+            tobj_id_val_pair1->id = MAP->at(&(workQueuePtr->pop));
+            lib->stmRead(T1, tobj_id_val_pair1);
+        }
+
+        TM_END(T1, lib);
+
         if (coordinatePairPtr == NULL) {
+            phaseEnd(statsPtr, FALSE);
             break;
         }
+#endif /* !USE_PATH_TICKETS */
+        phaseEnd(statsPtr, FALSE);
 
         coordinate_t* srcPtr = (coordinate_t*)coordinatePairPtr->firstPtr;
         coordinate_t* dstPtr = (coordinate_t*)coordinatePairPtr->secondPtr;
 
-		 //   printf("Expansion (%li, %li, %li) -> (%li, %li, %li):\n",
-         //  srcPtr->x, srcPtr->y, srcPtr->z,
-         //  dstPtr->x, dstPtr->y, dstPtr->z);
-
-        bool_t success = FALSE;
-        vector_t* pointVectorPtr = NULL;
-
-        //TM_BEGIN();
-        LTransaction* T2 = new LTransaction;
-        startTime = timeRequest();
-		T2->g_its = NIL;
-		
-		label2: while(true) {
-			if(T2->g_its != NIL) {
-				long int its = T2->g_its;
-				T2 = lib->tbegin(its);
-				tx++;
-			} else {
-				T2 = lib->tbegin(T2->g_its);
-				tx++;
-			}
-        
-			//grid_copy(T2, lib, MAP, myGridPtr, gridPtr); /* ok if not most up-to-date */ // Consider the TM copying.
-			if(T2->g_valid == ABORTED)
-			{
-				goto label2;
-			}
-			
-			if (PdoExpansion(routerPtr, myGridPtr, myExpansionQueuePtr,
-							 srcPtr, dstPtr)) {
-				pointVectorPtr = PdoTraceback(gridPtr, myGridPtr, dstPtr, bendCost);
-				/*
-				 * TODO: fix memory leak
-				 *
-				 * pointVectorPtr will be a memory leak if we abort this transaction
-				 */
-				if (pointVectorPtr) {
-					count++;
-					//std::cout<<count;
-					TMGRID_ADDPATH(T2, lib, MAP, gridPtr, pointVectorPtr);
-					if(T2->g_valid == ABORTED)
-					{
-						goto label2;
-					}
-					//TM_LOCAL_WRITE(success, TRUE);
-					success = TRUE;
-				}
-			}
-			//TM_END();
-			/* Try to commit the current transaction. If stmTryCommit returns ABORTED then retry this transaction again. */
-			if(lib->stmTryCommit(T2) == ABORTED) {
-				continue;
-			}
-			endTime = timeRequest();
-			// Break out of the while loop since the transaction has committed
-			if(routerArgPtr->time[thread_getId()] < (endTime-startTime))
-				routerArgPtr->time[thread_getId()] = (endTime-startTime);			
-			
-			break;
-		}
-       
+        bool_t success;
+        vector_t* pointVectorPtr;
+
+        TM_BEGIN(T2, lib);
+        phaseRestart(statsPtr);
+        success = FALSE;
+        pointVectorPtr = NULL;
+
+        phaseBegin(statsPtr, PHASE_COPY);
+        grid_copy(T2, lib, MAP, myGridPtr, gridPtr); /* ok if not most up-to-date */
+
+        phaseBegin(statsPtr, PHASE_EXPANSION);
+        if (PdoExpansion(routerPtr, myGridPtr, myExpansionQueuePtr,
+                         srcPtr, dstPtr)) {
+            phaseBegin(statsPtr, PHASE_TRACEBACK);
+            pointVectorPtr = TMdoTraceback(T2, lib, gridPtr, myGridPtr, dstPtr, bendCost);
+            if (pointVectorPtr) {
+                phaseBegin(statsPtr, PHASE_ADDPATH);
+                /* Add the path in a nested transaction: a conflict on a grid cell retries
+                 * only the insertion and keeps the expansion, until tbeginNested gives up
+                 * and jumps back to TM_BEGIN of T2. A cell taken by another path would be
+                 * found taken again by every retry, so T2 is retried at once to route
+                 * the path around it. */
+                while(true) {
+                    LTransaction* T2n = lib->tbeginNested(T2);
+                    if (!TMGRID_ADDPATH(T2n, lib, MAP, gridPtr, pointVectorPtr)) {
+                        TM_RESTART(T2, lib);
+                    }
+                    if(T2n->g_valid == ABORTED) {
+                        statsPtr->retries[PHASE_ADDPATH]++;
+                        continue;
+                    }
+                    if(lib->stmTryCommit(T2n) == ABORTED) {
+                        statsPtr->retries[PHASE_ADDPATH]++;
+                        continue;
+                    }
+                    break;
+                }
+                success = TRUE;
+            }
+        }
+
+        phaseBegin(statsPtr, PHASE_COMMIT);
+        TM_END(T2, lib);
+        phaseEnd(statsPtr, FALSE);
 
         if (success) {
             bool_t status = PVECTOR_PUSHBACK(myPathVectorPtr,
                                              (void*)pointVectorPtr);
             assert(status);
+            statsPtr->points += vector_getSize(pointVectorPtr);
         }
 
     }
 
-	//std::cout<<"Vector Size "<<vector_getSize(myPathVectorPtr)<<endl;
     /*
      * Add my paths to global list
      */
- //   list_t* pathVectorListPtr = routerArgPtr->pathVectorListPtr;
-    //TM_BEGIN();
-    LTransaction* T3 = new LTransaction;
-    startTime = timeRequest();
-	T3->g_its = NIL;
-	
-	label3: while(true) {
-		if(T3->g_its != NIL) {
-			long int its = T3->g_its;
-			T3 = lib->tbegin(its);
-			tx++;
-		} else {
-			T3 = lib->tbegin(T3->g_its);
-			tx++;
-		}
-    
-//		TMLIST_INSERT(T3, pathVectorListPtr, (void*)myPathVectorPtr);
-		/*Rather insert the parths in the global list, as we just need count so we will just add the size of myPathVectorPtr in the shared variable called numpath*/
-		TobIdValPair *tobj_id_val_pair = new TobIdValPair;
-		tobj_id_val_pair->id = MAP->at(tm_numPathRouted);
-		if(lib->stmRead(T3, tobj_id_val_pair) == ABORTED)
-		{
-			goto label3;
-		}
-		tobj_id_val_pair->val += vector_getSize(myPathVectorPtr);
-		lib->stmWrite(T3, tobj_id_val_pair);
-		
-		
-		//TM_END();
-		/* Try to commit the current transaction. If stmTryCommit returns ABORTED then retry this transaction again. */
-		if(lib->stmTryCommit(T3) == ABORTED) {
-			continue;
-		}
-		endTime = timeRequest();
-		// Break out of the while loop since the transaction has committed
-		if(routerArgPtr->time[thread_getId()] < (endTime-startTime))
-			routerArgPtr->time[thread_getId()] = (endTime-startTime);
-		break;
-	}
-    
+    TM_BEGIN(T3, lib);
+    phaseRestart(statsPtr);
+    phaseBegin(statsPtr, PHASE_COMMIT);
+    /* Rather than inserting the paths in the global list, add the size of myPathVectorPtr to
+     * the shared count numPathRouted. The count is only incremented, so routers do not conflict on it. */
+    lib->stmAdd(T3, MAP->at(tm_numPathRouted), vector_getSize(myPathVectorPtr));
+    TM_END(T3, lib);
+    phaseEnd(statsPtr, FALSE);
 
     PGRID_FREE(myGridPtr);
     PQUEUE_FREE(myExpansionQueuePtr);
@@ -590,9 +754,36 @@ int count=0;
 #endif /* DEBUG */
 
     TM_THREAD_EXIT();
-    endTimeTotal = timeRequest();
-    
-    routerArgPtr->totalTime[thread_getId()] = (endTimeTotal - startTimeTotal)/tx;
+}
+
+
+/* =============================================================================
+ * router_reportPhases
+ * =============================================================================
+ */
+void
+router_reportPhases (router_solve_arg_t* routerArgPtr, long numThread)
+{
+    static const char* names[NUM_PHASE] = {
+        "pop", "copy", "expansion", "traceback", "addpath", "commit"
+    };
+    printf("Phase          total (s)      count    retries   avg (us)   max (us)\n");
+    for (long phase = 0; phase < NUM_PHASE; phase++) {
+        long ns = 0;
+        long maxNs = 0;
+        long count = 0;
+        long retries = 0;
+        for (long t = 0; t < numThread; t++) {
+            router_phase_stats_t* statsPtr = &routerArgPtr->phases[t];
+            ns += statsPtr->ns[phase];
+            maxNs = std::max(maxNs, statsPtr->maxNs[phase]);
+            count += statsPtr->count[phase];
+            retries += statsPtr->retries[phase];
+        }
+        printf("%-10s %13.6f %10li %10li %10.2f %10.2f\n", names[phase],
+               ns / 1e9, count, retries,
+               ((count + retries) ? ns / 1e3 / (count + retries) : 0.0), maxNs / 1e3);
+    }
 }
 
 
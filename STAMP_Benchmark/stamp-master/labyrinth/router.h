@@ -85,15 +85,49 @@ typedef struct router {
     long bendCost;
 } router_t;
 
+/* Phases of routing a path, timed by every router thread */
+enum router_phase {
+    PHASE_NONE = -1,
+    PHASE_POP,        /* taking the next path, T1 or a ticket */
+    PHASE_COPY,       /* grid_copy of the shared grid */
+    PHASE_EXPANSION,
+    PHASE_TRACEBACK,
+    PHASE_ADDPATH,    /* nested transactions adding the path to the grid */
+    PHASE_COMMIT,     /* commit of T2, and of T3 at the end */
+    NUM_PHASE
+};
+
+/* steady_clock time spent in each phase by one thread, the times it ran to
+ * the end and the times a transaction aborted in it, on a cache line of its
+ * own. The running phase is kept here rather than in locals, which an abort
+ * jumping back to TM_BEGIN would lose. */
+typedef struct alignas(64) router_phase_stats {
+    long ns[NUM_PHASE];
+    long maxNs[NUM_PHASE];
+    long count[NUM_PHASE];
+    long retries[NUM_PHASE];
+    long current;
+    long since;
+    /* grid points of the paths the thread routed, to compare expansions */
+    long points;
+} router_phase_stats_t;
+
 typedef struct router_solve_arg {
 	KSFTM *lib;
-	map<long int*, long int> *MAP;
+	AddrMap *MAP;
     router_t* routerPtr;
     maze_t* mazePtr;
     list_t* pathVectorListPtr; 
     long *tm_numPathRouted;
-    float time[64];
-    float totalTime[64];
+    router_phase_stats_t phases[64];
+    /* Ticket dispenser of the work queue: the queue is filled before the
+     * routers start and only drained by them, so with USE_PATH_TICKETS a
+     * router takes path firstPath + nextPath++ (mod capacity) by a
+     * fetch-and-add, instead of popping it in a transaction that every
+     * router conflicts on. */
+    long firstPath;
+    long numPath;
+    std::atomic<long> nextPath;
 } router_solve_arg_t;
 
 
@@ -121,6 +155,15 @@ void
 router_solve (void* argPtr);
 
 
+/* =============================================================================
+ * router_reportPhases
+ * -- Prints the time, count and aborts of every phase over all threads
+ * =============================================================================
+ */
+void
+router_reportPhases (router_solve_arg_t* routerArgPtr, long numThread);
+
+
 #endif /* ROUTER_H */
 
 
@@ -247,7 +247,7 @@ TMheap_insert (TM_ARGDECL  heap_t* heapPtr, void* dataPtr)
         for (i = 0; i <= size; i++) {
             newElements[i] = (void*)TM_SHARED_READ_P(elements[i]);
         }
-        TM_FREE(heapPtr->elements);
+        TM_FREE(elements);
         TM_SHARED_WRITE(heapPtr->elements, newElements);
     }
 
@@ -120,7 +120,7 @@ list_iter_reset (list_iter_t* itPtr, list_t* listPtr)
 /* =============================================================================
  * TMlist_iter_reset
  * =============================================================================
- *//*
+ */
 void
 TMlist_iter_reset (TM_ARGDECL  list_iter_t* itPtr, list_t* listPtr)
 {
@@ -142,7 +142,7 @@ list_iter_hasNext (list_iter_t* itPtr, list_t* listPtr)
 /* =============================================================================
  * TMlist_iter_hasNext
  * =============================================================================
- *//*
+ */
 bool_t
 TMlist_iter_hasNext (TM_ARGDECL  list_iter_t* itPtr, list_t* listPtr)
 {
@@ -168,7 +168,7 @@ list_iter_next (list_iter_t* itPtr, list_t* listPtr)
 /* =============================================================================
  * TMlist_iter_next
  * =============================================================================
- *//*
+ */
 void*
 TMlist_iter_next (TM_ARGDECL  list_iter_t* itPtr, list_t* listPtr)
 {
@@ -300,7 +300,7 @@ Plist_alloc (long (*compare)(const void*, const void*))
  * -- If NULL passed for 'compare' function, will compare data pointer addresses
  * -- Returns NULL on failure
  * =============================================================================
- *//*
+ */
 list_t*
 TMlist_alloc (TM_ARGDECL  long (*compare)(const void*, const void*))
 {
@@ -315,7 +315,7 @@ TMlist_alloc (TM_ARGDECL  long (*compare)(const void*, const void*))
 
     if (compare == NULL) {
         listPtr->compare = &compareDataPtrAddresses; /* default */
- /*   } else {
+    } else {
         listPtr->compare = compare;
     }
 
@@ -348,7 +348,7 @@ PfreeNode (list_node_t* nodePtr)
 /* =============================================================================
  * TMfreeNode
  * =============================================================================
- *//*
+ */
 static void
 TMfreeNode (TM_ARGDECL  list_node_t* nodePtr)
 {
@@ -387,7 +387,7 @@ PfreeList (list_node_t* nodePtr)
 /* =============================================================================
  * TMfreeList
  * =============================================================================
- *//*
+ */
 static void
 TMfreeList (TM_ARGDECL  list_node_t* nodePtr)
 {
@@ -426,7 +426,7 @@ Plist_free (list_t* listPtr)
 /* =============================================================================
  * TMlist_free
  * =============================================================================
- *//*
+ */
 void
 TMlist_free (TM_ARGDECL  list_t* listPtr)
 {
@@ -452,7 +452,7 @@ list_isEmpty (list_t* listPtr)
  * TMlist_isEmpty
  * -- Return TRUE if list is empty, else FALSE
  * =============================================================================
- *//*
+ */
 bool_t
 TMlist_isEmpty (TM_ARGDECL  list_t* listPtr)
 {
@@ -477,7 +477,7 @@ list_getSize (list_t* listPtr)
  * TMlist_getSize
  * -- Returns the size of the list
  * =============================================================================
- *//*
+ */
 long
 TMlist_getSize (TM_ARGDECL  list_t* listPtr)
 {
@@ -510,7 +510,6 @@ findPrevious (list_t* listPtr, void* dataPtr)
  * TMfindPrevious
  * =============================================================================
  */
- /*
 static list_node_t*
 TMfindPrevious (TM_ARGDECL  list_t* listPtr, void* dataPtr)
 {
@@ -557,7 +556,7 @@ list_find (list_t* listPtr, void* dataPtr)
  * TMlist_find
  * -- Returns NULL if not found, else returns pointer to data
  * =============================================================================
- *//*
+ */
 void*
 TMlist_find (TM_ARGDECL  list_t* listPtr, void* dataPtr)
 {
@@ -650,8 +649,8 @@ Plist_insert (list_t* listPtr, void* dataPtr)
  * -- Return TRUE on success, else FALSE
  * =============================================================================
  */
-/*bool_t
-TMlist_insert (LTransaction *T, TM_ARGDECL  list_t* listPtr, void* dataPtr)
+bool_t
+TMlist_insert (TM_ARGDECL  list_t* listPtr, void* dataPtr)
 {
     list_node_t* prevPtr;
     list_node_t* nodePtr;
@@ -744,7 +743,6 @@ Plist_remove (list_t* listPtr, void* dataPtr)
  * -- Returns TRUE if successful, else FALSE
  * =============================================================================
  */
- /*
 bool_t
 TMlist_remove (TM_ARGDECL  list_t* listPtr, void* dataPtr)
 {
@@ -289,7 +289,7 @@ Plist_insert (list_t* listPtr, void* dataPtr);
  */
 TM_CALLABLE
 bool_t
-TMlist_insert (LTransaction *T, TM_ARGDECL  list_t* listPtr, void* dataPtr);
+TMlist_insert (TM_ARGDECL  list_t* listPtr, void* dataPtr);
 
 
 /* =============================================================================
@@ -354,7 +354,7 @@ Plist_clear (list_t* listPtr);
 #define TMLIST_GETSIZE(list)            TMlist_getSize(TM_ARG  list)
 #define TMLIST_ISEMPTY(list)            TMlist_isEmpty(TM_ARG  list)
 #define TMLIST_FIND(list, data)         TMlist_find(TM_ARG  list, data)
-#define TMLIST_INSERT(T, list, data)       TMlist_insert(T, TM_ARG  list, data)
+#define TMLIST_INSERT(list, data)       TMlist_insert(TM_ARG  list, data)
 #define TMLIST_REMOVE(list, data)       TMlist_remove(TM_ARG  list, data)
 
 
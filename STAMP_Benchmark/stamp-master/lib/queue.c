@@ -77,7 +77,9 @@
 #include "types.h"
 #include "queue.h"
 #include "pair.h"
-#include "../labyrinth/coordinate.h"
+#ifdef QUEUE_COORDINATE_PAIRS
+#  include "../labyrinth/coordinate.h"
+#endif
 enum config {
     QUEUE_GROWTH_FACTOR = 2,
 };
@@ -138,6 +140,32 @@ Pqueue_alloc (long initCapacity)
  * =============================================================================
  */
 queue_t*
+TMqueue_alloc (LTransaction *T, KSFTM *lib, TM_ARGDECL  long initCapacity)
+{
+    queue_t* queuePtr = (queue_t*)TM_MALLOC(T, lib, sizeof(queue_t));
+
+    if (queuePtr) {
+        long capacity = ((initCapacity < 2) ? 2 : initCapacity);
+        queuePtr->elements = (void**)TM_MALLOC(T, lib, capacity * sizeof(void*));
+        if (queuePtr->elements == NULL) {
+            TM_FREE(T, lib, queuePtr);
+            return NULL;
+        }
+        queuePtr->pop      = capacity - 1;
+        queuePtr->push     = 0;
+        queuePtr->capacity = capacity;
+    }
+
+    return queuePtr;
+}
+
+
+/* =============================================================================
+ * TMqueue_alloc
+ * -- Word based form
+ * =============================================================================
+ */
+queue_t*
 TMqueue_alloc (TM_ARGDECL  long initCapacity)
 {
     queue_t* queuePtr = (queue_t*)TM_MALLOC(sizeof(queue_t));
@@ -146,7 +174,7 @@ TMqueue_alloc (TM_ARGDECL  long initCapacity)
         long capacity = ((initCapacity < 2) ? 2 : initCapacity);
         queuePtr->elements = (void**)TM_MALLOC(capacity * sizeof(void*));
         if (queuePtr->elements == NULL) {
-            free(queuePtr);
+            TM_FREE(queuePtr);
             return NULL;
         }
         queuePtr->pop      = capacity - 1;
@@ -186,7 +214,7 @@ Pqueue_free (queue_t* queuePtr)
  * TMqueue_free
  * =============================================================================
  */
-/*void
+void
 TMqueue_free (TM_ARGDECL  queue_t* queuePtr)
 {
     TM_FREE((void**)TM_SHARED_READ_P(queuePtr->elements));
@@ -209,6 +237,22 @@ queue_isEmpty (queue_t* queuePtr)
 }
 
 
+/* =============================================================================
+ * TMqueue_isEmpty
+ * -- Word based form
+ * =============================================================================
+ */
+bool_t
+TMqueue_isEmpty (TM_ARGDECL  queue_t* queuePtr)
+{
+    long pop      = (long)TM_SHARED_READ(queuePtr->pop);
+    long push     = (long)TM_SHARED_READ(queuePtr->push);
+    long capacity = (long)TM_SHARED_READ(queuePtr->capacity);
+
+    return (((pop + 1) % capacity == push) ? TRUE : FALSE);
+}
+
+
 /* =============================================================================
  * queue_clear
  * =============================================================================
@@ -226,7 +270,7 @@ queue_clear (queue_t* queuePtr)
  * =============================================================================
  */
 bool_t
-TMqueue_isEmpty (LTransaction *T, KSFTM *lib, map<long int*, long int> *MAP, TM_ARGDECL  queue_t* queuePtr)
+TMqueue_isEmpty (LTransaction *T, KSFTM *lib, AddrMap *MAP, TM_ARGDECL  queue_t* queuePtr)
 {
 	//long pop      = (long)TM_SHARED_READ(queuePtr->pop);
 	TobIdValPair *tobj_id_val_pair1 = new TobIdValPair;
@@ -409,10 +453,10 @@ Pqueue_push (queue_t* queuePtr, void* dataPtr)
 
 
 /* =============================================================================
- * TMqueue_push (Commented for Labyrinth)
+ * TMqueue_push
  * =============================================================================
  */
-/*bool_t
+bool_t
 TMqueue_push (TM_ARGDECL  queue_t* queuePtr, void* dataPtr)
 {
     long pop      = (long)TM_SHARED_READ(queuePtr->pop);
@@ -422,7 +466,7 @@ TMqueue_push (TM_ARGDECL  queue_t* queuePtr, void* dataPtr)
     assert(pop != push);
 
     /* Need to resize */
- /*   long newPush = (push + 1) % capacity;
+    long newPush = (push + 1) % capacity;
     if (newPush == pop) {
         long newCapacity = capacity * QUEUE_GROWTH_FACTOR;
         void** newElements = (void**)TM_MALLOC(newCapacity * sizeof(void*));
@@ -454,7 +498,7 @@ TMqueue_push (TM_ARGDECL  queue_t* queuePtr, void* dataPtr)
         push = dst;
         newPush = push + 1; /* no need modulo */
 
-  /*  }
+    }
 
     void** elements = (void**)TM_SHARED_READ_P(queuePtr->elements);
     TM_SHARED_WRITE_P(elements[push], dataPtr);
@@ -487,12 +531,14 @@ queue_pop (queue_t* queuePtr)
 }
 
 
+#ifdef QUEUE_COORDINATE_PAIRS
 /* =============================================================================
  * TMqueue_pop
+ * -- Elements are pairs of labyrinth coordinates, which are copied out
  * =============================================================================
  */
 void*
-TMqueue_pop (LTransaction *T, KSFTM *lib, map<long int*, long int> *MAP, TM_ARGDECL  queue_t* queuePtr)
+TMqueue_pop (LTransaction *T, KSFTM *lib, AddrMap *MAP, TM_ARGDECL  queue_t* queuePtr)
 {
 
 	//long pop      = (long)TM_SHARED_READ(queuePtr->pop);
@@ -604,6 +650,32 @@ TMqueue_pop (LTransaction *T, KSFTM *lib, map<long int*, long int> *MAP, TM_ARGD
 	
     return dataPtr;
 }
+#endif /* QUEUE_COORDINATE_PAIRS */
+
+
+/* =============================================================================
+ * TMqueue_pop
+ * -- Word based form
+ * =============================================================================
+ */
+void*
+TMqueue_pop (TM_ARGDECL  queue_t* queuePtr)
+{
+    long pop      = (long)TM_SHARED_READ(queuePtr->pop);
+    long push     = (long)TM_SHARED_READ(queuePtr->push);
+    long capacity = (long)TM_SHARED_READ(queuePtr->capacity);
+
+    long newPop = (pop + 1) % capacity;
+    if (newPop == push) {
+        return NULL;
+    }
+
+    void** elements = (void**)TM_SHARED_READ_P(queuePtr->elements);
+    void* dataPtr = (void*)TM_SHARED_READ_P(elements[newPop]);
+    TM_SHARED_WRITE(queuePtr->pop, newPop);
+
+    return dataPtr;
+}
 
 
 /* =============================================================================
@@ -156,7 +156,7 @@ queue_isEmpty (queue_t* queuePtr);
  */
 TM_CALLABLE
 bool_t
-TMqueue_isEmpty (LTransaction *T, KSFTM *lib, map<long int*, long int> *MAP, TM_ARGDECL  queue_t* queuePtr);
+TMqueue_isEmpty (TM_ARGDECL  queue_t* queuePtr);
 
 
 /* =============================================================================
@@ -214,7 +214,7 @@ queue_pop (queue_t* queuePtr);
  */
 TM_CALLABLE
 void*
-TMqueue_pop (LTransaction *T, KSFTM *lib, map<long int*, long int> *MAP, TM_ARGDECL  queue_t* queuePtr);
+TMqueue_pop (TM_ARGDECL  queue_t* queuePtr);
 
 
 #define PQUEUE_ALLOC(c)     Pqueue_alloc(c)
@@ -225,11 +225,23 @@ TMqueue_pop (LTransaction *T, KSFTM *lib, map<long int*, long int> *MAP, TM_ARGD
 #define PQUEUE_PUSH(q, d)   Pqueue_push(q, (void*)(d))
 #define PQUEUE_POP(q)       queue_pop(q)
 
-#define TMQUEUE_ALLOC(c)    TMqueue_alloc(TM_ARG_ALONE  c)
+/*
+ * TMQUEUE_ALLOC, TMQUEUE_ISEMPTY and TMQUEUE_POP take either the stock
+ * arguments, for the word based interface, or the KSFTM transaction,
+ * instance and address map first, as labyrinth does.
+ */
+#define TMQUEUE_ALLOC(...)  TM_SELECT3(__VA_ARGS__, TMQUEUE_ALLOC_KSFTM, ~, TMQUEUE_ALLOC_WORD, ~)(__VA_ARGS__)
 #define TMQUEUE_FREE(q)     TMqueue_free(TM_ARG  q)
-#define TMQUEUE_ISEMPTY(T, lib, MAP, q)  TMqueue_isEmpty(T, lib, MAP, TM_ARG  q)
-//#define TMQUEUE_PUSH(q, d)  TMqueue_push(TM_ARG  q, (void*)(d))
-#define TMQUEUE_POP(T, lib, MAP, q)      TMqueue_pop(T, lib, MAP, TM_ARG  q)
+#define TMQUEUE_ISEMPTY(...) TM_SELECT4(__VA_ARGS__, TMQUEUE_ISEMPTY_KSFTM, ~, ~, TMQUEUE_ISEMPTY_WORD, ~)(__VA_ARGS__)
+#define TMQUEUE_PUSH(q, d)  TMqueue_push(TM_ARG  q, (void*)(d))
+#define TMQUEUE_POP(...)    TM_SELECT4(__VA_ARGS__, TMQUEUE_POP_KSFTM, ~, ~, TMQUEUE_POP_WORD, ~)(__VA_ARGS__)
+
+#define TMQUEUE_ALLOC_WORD(c)                   TMqueue_alloc(TM_ARG  c)
+#define TMQUEUE_ISEMPTY_WORD(q)                 TMqueue_isEmpty(TM_ARG  q)
+#define TMQUEUE_POP_WORD(q)                     TMqueue_pop(TM_ARG  q)
+#define TMQUEUE_ALLOC_KSFTM(T, lib, c)          TMqueue_alloc(T, lib, TM_ARG  c)
+#define TMQUEUE_ISEMPTY_KSFTM(T, lib, MAP, q)   TMqueue_isEmpty(T, lib, MAP, TM_ARG  q)
+#define TMQUEUE_POP_KSFTM(T, lib, MAP, q)       TMqueue_pop(T, lib, MAP, TM_ARG  q)
 
 
 #ifdef __cplusplus
@@ -237,6 +249,26 @@ TMqueue_pop (LTransaction *T, KSFTM *lib, map<long int*, long int> *MAP, TM_ARGD
 #endif
 
 
+/* =============================================================================
+ * TMqueue_alloc, TMqueue_isEmpty, TMqueue_pop
+ * -- Forms that access the queue through the KSFTM tobjs of labyrinth;
+ *    overloads of the word based forms, so they have C++ linkage
+ * -- TMqueue_pop copies out pairs of coordinates, so it is only built with
+ *    QUEUE_COORDINATE_PAIRS (set by labyrinth)
+ * =============================================================================
+ */
+queue_t*
+TMqueue_alloc (LTransaction *T, KSFTM *lib, TM_ARGDECL  long initCapacity);
+
+bool_t
+TMqueue_isEmpty (LTransaction *T, KSFTM *lib, AddrMap *MAP, TM_ARGDECL  queue_t* queuePtr);
+
+#ifdef QUEUE_COORDINATE_PAIRS
+void*
+TMqueue_pop (LTransaction *T, KSFTM *lib, AddrMap *MAP, TM_ARGDECL  queue_t* queuePtr);
+#endif
+
+
 #endif /* QUEUE_H */
 
 
@@ -73,6 +73,7 @@
 #include <stdlib.h>
 #include "thread.h"
 #include "types.h"
+#include "../../../Affinity.h"
 
 static THREAD_LOCAL_T    global_threadId;
 static long              global_numThread       = 1;
@@ -97,6 +98,9 @@ threadWait (void* argPtr)
 
     THREAD_LOCAL_SET(global_threadId, (long)threadId);
 
+    /* Pin as $STM_AFFINITY says (compact, scatter or node), see Affinity.h */
+    pinThread(threadId, global_numThread, affinityFromEnv(AFFINITY_NONE));
+
     while (1) {
         THREAD_BARRIER(global_barrierPtr, threadId); /* wait for start parallel */
         if (global_doShutdown) {
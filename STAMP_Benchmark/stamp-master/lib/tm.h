@@ -80,7 +80,7 @@
 #include<pthread.h>
 #include<setjmp.h>
 #include <string.h>
-#include "../../tl2/stm.h"
+#include "../../tl2/wstm.h"
 #include "thread.h"
 #include <map>
 
@@ -174,25 +174,29 @@ extern __thread int tid; // or -1
  * P_FREE(ptr)
  *     Deallocate memory inside parallel region
  *
- * TM_MALLOC(size)
+ * TM_MALLOC(size), TM_MALLOC(T, lib, size)
  *     Allocate memory inside atomic block / transaction
  *
- * TM_FREE(ptr)
- *     Deallocate memory inside atomic block / transaction
+ * TM_FREE(ptr), TM_FREE(T, lib, ptr)
+ *     Deallocate memory inside atomic block / transaction, on commit
  *
- * TM_BEGIN()
- *     Begin atomic block / transaction
+ * TM_BEGIN(), TM_BEGIN(T, lib)
+ *     Begin atomic block / transaction; the second form declares the KSFTM
+ *     transaction T and checkpoints it, so any abort of T jumps back here
  *
  * TM_BEGIN_RO()
  *     Begin atomic block / transaction that only reads shared data
  *
- * TM_END()
+ * TM_END(), TM_END(T, lib)
  *     End atomic block / transaction
  *
- * TM_RESTART()
+ * TM_RESTART(), TM_RESTART(T, lib)
  *     Restart atomic block / transaction
  *
- * TM_EARLY_RELEASE()
+ * TM_RETRY(T, lib)
+ *     Abort and wait until something read by the transaction changes
+ *
+ * TM_EARLY_RELEASE(var), TM_EARLY_RELEASE(T, lib, MAP, var)
  *     Remove speculatively read line from the read set
  *
  * =============================================================================
@@ -228,9 +232,9 @@ extern __thread int tid; // or -1
  *     void subfunction2 (TM_ARGDECL  long a, long b, long c)
  *     {
  *         TM_BEGIN();
- *         long* array = (long*)TM_MALLOC(a * b * c * sizeof(long));
+ *         long* array = (long*)TM_MALLOC(T, lib, a * b * c * sizeof(long));
  *         // ... do work that may read or write shared data ...
- *         TM_FREE(array);
+ *         TM_FREE(T, lib, array);
  *         TM_END();
  *     }
  *
@@ -258,8 +262,8 @@ extern __thread int tid; // or -1
 #    define TM_ARGDECL_ALONE              STM_THREAD_T* TM_ARG_ALONE
 #    define TM_CALLABLE                   /* nothing */
 
-//#      define TM_STARTUP(numThread)     STM_STARTUP(numThread)
-//#      define TM_SHUTDOWN()             tm_shutdown()
+#      define TM_STARTUP(numThread)     STM_STARTUP(numThread)
+#      define TM_SHUTDOWN()             STM_SHUTDOWN()
 
 #      define TM_THREAD_ENTER()         TM_ARGDECL_ALONE = STM_NEW_THREAD(); \
                                         STM_INIT_THREAD(TM_ARG_ALONE, thread_getId()); \
@@ -268,16 +272,43 @@ extern __thread int tid; // or -1
 
 #      define P_MALLOC(size)            malloc(size)
 #      define P_FREE(ptr)               free(ptr)
-#      define TM_MALLOC(size)           malloc(size)
-//#      define TM_FREE(ptr)              STM_FREE(ptr)
-
-
-//#    define TM_BEGIN()               STM_BEGIN_WR(&tid)
-//#    define TM_BEGIN_RO()               STM_BEGIN_RD()
-//#    define TM_END()                 STM_END(tid)
-//#    define TM_RESTART()                STM_RESTART()
 
-#    define TM_EARLY_RELEASE(var)       /* nothing */
+/*
+ * TM_MALLOC, TM_FREE and TM_EARLY_RELEASE take either the stock STAMP
+ * arguments, for the word based interface, or the KSFTM transaction and
+ * instance first, for code written against KSFTM directly like labyrinth.
+ */
+#      define TM_SELECT3(_1, _2, _3, NAME, ...)      NAME
+#      define TM_SELECT4(_1, _2, _3, _4, NAME, ...)  NAME
+#      define TM_MALLOC(...)            TM_SELECT3(__VA_ARGS__, TM_MALLOC_KSFTM, TM_MALLOC_KSFTM, STM_MALLOC, ~)(__VA_ARGS__)
+#      define TM_FREE(...)              TM_SELECT3(__VA_ARGS__, TM_FREE_KSFTM, TM_FREE_KSFTM, STM_FREE, ~)(__VA_ARGS__)
+#      define TM_MALLOC_KSFTM(T, lib, size)   lib->stmMalloc(T, size)
+#      define TM_FREE_KSFTM(T, lib, ptr)      lib->stmFree(T, ptr)
+
+/*
+ * TM_BEGIN(T, lib) sets a checkpoint with sigsetjmp and begins T with it, or
+ * again with the its of the aborted attempt after a jump back. Locals that
+ * are changed inside the transaction and read after a restart without being
+ * assigned again must be volatile, as after any longjmp.
+ */
+#    define TM_BEGIN(...)               TM_SELECT3(__VA_ARGS__, ~, TM_BEGIN_KSFTM, TM_BEGIN_WORD, ~)(__VA_ARGS__)
+#    define TM_BEGIN_RO()               STM_BEGIN_RD()
+#    define TM_END(...)                 TM_SELECT3(__VA_ARGS__, ~, TM_END_KSFTM, TM_END_WORD, ~)(__VA_ARGS__)
+#    define TM_RESTART(...)             TM_SELECT3(__VA_ARGS__, ~, TM_RESTART_KSFTM, TM_RESTART_WORD, ~)(__VA_ARGS__)
+#    define TM_BEGIN_WORD()             STM_BEGIN_WR()
+#    define TM_END_WORD()               STM_END()
+#    define TM_RESTART_WORD()           STM_RESTART()
+#    define TM_BEGIN_KSFTM(T, lib)      sigjmp_buf T##_checkpoint; \
+                                        LTransaction* volatile T = NULL; \
+                                        sigsetjmp(T##_checkpoint, 0); \
+                                        T = lib->tbegin((T == NULL) ? NIL : T->g_its, &T##_checkpoint)
+#    define TM_END_KSFTM(T, lib)        lib->stmTryCommit(T)
+#    define TM_RESTART_KSFTM(T, lib)    do { lib->stmAbort(T); siglongjmp(T##_checkpoint, 1); } while(0)
+
+#    define TM_EARLY_RELEASE(...)       TM_SELECT4(__VA_ARGS__, TM_EARLY_RELEASE_KSFTM, TM_EARLY_RELEASE_KSFTM, TM_EARLY_RELEASE_KSFTM, TM_EARLY_RELEASE_WORD, ~)(__VA_ARGS__)
+#    define TM_EARLY_RELEASE_KSFTM(T, lib, MAP, var)  lib->stmRelease(T, MAP->at((long int*)&(var)))
+#    define TM_EARLY_RELEASE_WORD(var)  /* nothing: orecs are shared by words, so one read cannot be released alone */
+#    define TM_RETRY(T, lib)                    lib->stmRetry(T)
 
 
 
@@ -292,6 +323,18 @@ extern __thread int tid; // or -1
  * =============================================================================
  */
 
+#  define TM_SHARED_READ(var)           STM_READ(var)
+#  define TM_SHARED_READ_P(var)         STM_READ_P(var)
+#  define TM_SHARED_READ_F(var)         STM_READ_F(var)
+
+#  define TM_SHARED_WRITE(var, val)     STM_WRITE(var, val)
+#  define TM_SHARED_WRITE_P(var, val)   STM_WRITE_P(var, val)
+#  define TM_SHARED_WRITE_F(var, val)   STM_WRITE_F(var, val)
+
+#  define TM_LOCAL_WRITE(var, val)      STM_LOCAL_WRITE(var, val)
+#  define TM_LOCAL_WRITE_P(var, val)    STM_LOCAL_WRITE_P(var, val)
+#  define TM_LOCAL_WRITE_F(var, val)    STM_LOCAL_WRITE_F(var, val)
+
 /*#define FUNC_DECL(x, y)			\
 pc.push_back(x);						\
 c##x: y;									\
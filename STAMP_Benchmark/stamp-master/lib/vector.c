@@ -129,6 +129,32 @@ Pvector_alloc (long initCapacity)
 }
 
 
+/* =============================================================================
+ * TMvector_alloc
+ * -- Returns NULL if failed
+ * =============================================================================
+ */
+vector_t*
+TMvector_alloc (LTransaction *T, KSFTM *lib, long initCapacity)
+{
+    vector_t* vectorPtr;
+    long capacity = MAX(initCapacity, 1);
+
+    vectorPtr = (vector_t*)TM_MALLOC(T, lib, sizeof(vector_t));
+
+    if (vectorPtr != NULL) {
+        vectorPtr->size = 0;
+        vectorPtr->capacity = capacity;
+        vectorPtr->elements = (void**)TM_MALLOC(T, lib, capacity * sizeof(void*));
+        if (vectorPtr->elements == NULL) {
+            return NULL;
+        }
+    }
+
+    return vectorPtr;
+}
+
+
 /* =============================================================================
  * vector_free
  * =============================================================================
@@ -153,6 +179,18 @@ Pvector_free (vector_t* vectorPtr)
 }
 
 
+/* =============================================================================
+ * TMvector_free
+ * =============================================================================
+ */
+void
+TMvector_free (LTransaction *T, KSFTM *lib, vector_t* vectorPtr)
+{
+    TM_FREE(T, lib, vectorPtr->elements);
+    TM_FREE(T, lib, vectorPtr);
+}
+
+
 /* =============================================================================
  * vector_at
  * -- Returns NULL if failed
@@ -227,6 +265,35 @@ Pvector_pushBack (vector_t* vectorPtr, void* dataPtr)
 }
 
 
+/* =============================================================================
+ * TMvector_pushBack
+ * -- Returns FALSE if fail, else TRUE
+ * =============================================================================
+ */
+bool_t
+TMvector_pushBack (LTransaction *T, KSFTM *lib, vector_t* vectorPtr, void* dataPtr)
+{
+    if (vectorPtr->size == vectorPtr->capacity) {
+        long i;
+        long newCapacity = vectorPtr->capacity * 2;
+        void** newElements = (void**)TM_MALLOC(T, lib, newCapacity * sizeof(void*));
+        if (newElements == NULL) {
+            return FALSE;
+        }
+        vectorPtr->capacity = newCapacity;
+        for (i = 0; i < vectorPtr->size; i++) {
+            newElements[i] = vectorPtr->elements[i];
+        }
+        TM_FREE(T, lib, vectorPtr->elements);
+        vectorPtr->elements = newElements;
+    }
+
+    vectorPtr->elements[vectorPtr->size++] = dataPtr;
+
+    return TRUE;
+}
+
+
 /* =============================================================================
  * vector_popBack
  * Returns NULL if fail, else returns last element
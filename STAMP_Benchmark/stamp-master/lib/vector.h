@@ -107,6 +107,15 @@ vector_t*
 Pvector_alloc (long initCapacity);
 
 
+/* =============================================================================
+ * TMvector_alloc
+ * -- Returns NULL if failed
+ * =============================================================================
+ */
+vector_t*
+TMvector_alloc (LTransaction *T, KSFTM *lib, long initCapacity);
+
+
 /* =============================================================================
  * vector_free
  * =============================================================================
@@ -123,6 +132,14 @@ void
 Pvector_free (vector_t* vectorPtr);
 
 
+/* =============================================================================
+ * TMvector_free
+ * =============================================================================
+ */
+void
+TMvector_free (LTransaction *T, KSFTM *lib, vector_t* vectorPtr);
+
+
 /* =============================================================================
  * vector_at
  * -- Returns NULL if failed
@@ -150,6 +167,15 @@ bool_t
 Pvector_pushBack (vector_t* vectorPtr, void* dataPtr);
 
 
+/* =============================================================================
+ * TMvector_pushBack
+ * -- Returns FALSE if fail, else TRUE
+ * =============================================================================
+ */
+bool_t
+TMvector_pushBack (LTransaction *T, KSFTM *lib, vector_t* vectorPtr, void* dataPtr);
+
+
 /* =============================================================================
  * vector_popBack
  * -- Returns NULL if fail, else returns last element
@@ -209,6 +235,10 @@ Pvector_copy (vector_t* dstVectorPtr, vector_t* srcVectorPtr);
 #define PVECTOR_SORT(v, cmp)        vector_sort(v, cmp)
 #define PVECTOR_COPY(dst, src)      Pvector_copy(dst, src)
 
+#define TMVECTOR_ALLOC(T, lib, n)           TMvector_alloc(T, lib, n)
+#define TMVECTOR_FREE(T, lib, v)            TMvector_free(T, lib, v)
+#define TMVECTOR_PUSHBACK(T, lib, v, data)  TMvector_pushBack(T, lib, v, data)
+
 
 #ifdef __cplusplus
 }
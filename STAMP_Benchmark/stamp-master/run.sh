@@ -0,0 +1,76 @@
+#!/bin/sh
+#
+# Builds libtl2 and every STAMP application in this directory, runs each
+# with the thread counts in $THREADS and prints its runtime and the abort
+# rate reported by KSFTM. The arguments are the standard STAMP simulator
+# inputs; the input files of kmeans, labyrinth and yada are generated on the
+# first run.
+#
+#   ./run.sh                       all applications, 1 2 4 8 threads
+#   APPS="labyrinth" THREADS="1 16" ./run.sh
+#
+
+APPS=${APPS:-"bayes genome intruder kmeans labyrinth ssca2 vacation yada"}
+THREADS=${THREADS:-"1 2 4 8"}
+ROOT=`pwd`
+
+cd ../tl2;
+rm -f libtl2.a stm.o wstm.o;
+g++ -pthread -std=c++14 $STMFLAGS -c stm.cpp wstm.cpp || exit 1;
+ar -cq libtl2.a stm.o wstm.o;
+cd $ROOT;
+
+args() {
+	case $1 in
+	bayes)     echo "-v32 -r1024 -n2 -p20 -s0 -i2 -e2 -t$2" ;;
+	genome)    echo "-g256 -s16 -n16384 -t$2" ;;
+	intruder)  echo "-a10 -l4 -n2048 -s1 -t$2" ;;
+	kmeans)    echo "-m15 -n15 -t0.05 -i inputs/random-n2048-d16-c16.txt -p$2" ;;
+	labyrinth) echo "-i inputs/random-x32-y32-z3-n96.txt -t$2" ;;
+	ssca2)     echo "-s13 -i1.0 -u1.0 -l3 -p3 -t$2" ;;
+	vacation)  echo "-n4 -q60 -u90 -r16384 -t4096 -c$2" ;;
+	yada)      echo "-a20 -i inputs/grid-x32-y32 -t$2" ;;
+	esac
+}
+
+#writes the input of an application, named as in args
+generate() {
+	case $1 in
+	kmeans)    inputs/generate 2048 16 16 > $2 ;;
+	labyrinth) inputs/generate `echo $2 | sed -n 's/.*-x\([0-9]*\)-y\([0-9]*\)-z\([0-9]*\)-n\([0-9]*\)\.txt/\1 \2 \3 \4/p'` > $2 ;;
+	yada)      inputs/generate 32 32 $2 ;;
+	esac
+}
+
+#the line each application prints its runtime on
+timeline() {
+	case $1 in
+	bayes)     echo "Learn time" ;;
+	ssca2)     echo "Time taken for all" ;;
+	*)         echo "[Tt]ime" ;;
+	esac
+}
+
+printf "%-10s %8s %12s %12s\n" "app" "threads" "time (s)" "abort rate"
+for app in $APPS; do
+	cd $ROOT/$app;
+	rm -f $app *.o ../lib/*.o;
+	make -f Makefile.stm > build.log 2>&1 || { echo "$app: build failed, see $app/build.log"; exit 1; }
+	input=`args $app 1 | sed -n 's/.*-i \([^ ]*\).*/\1/p'`
+	#yada reads the .node, .poly and .ele files of its input prefix
+	file=$input
+	[ $app = yada ] && file=$input.node
+	if [ -n "$input" ] && [ ! -f "$file" ]; then
+		make -f Makefile.stm generate >> build.log 2>&1 && generate $app $input
+	fi
+	if [ -n "$input" ] && [ ! -f "$file" ]; then
+		printf "%-10s %8s %12s %12s\n" $app "-" "input failed" "-"
+		continue
+	fi
+	for t in $THREADS; do
+		out=`./$app \`args $app $t\` 2>&1`
+		time=`echo "$out" | grep "\`timeline $app\`" | sed -n 's/^[^0-9]*\([0-9.]*\).*/\1/p' | head -1`
+		rate=`echo "$out" | sed -n 's/.*Abort rate = \([0-9.]*%\).*/\1/p' | tail -1`
+		printf "%-10s %8s %12s %12s\n" $app $t ${time:-"?"} ${rate:-"?"}
+	done
+done
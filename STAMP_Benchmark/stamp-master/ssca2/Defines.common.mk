@@ -0,0 +1,32 @@
+# ==============================================================================
+#
+# Defines.common.mk
+#
+# ==============================================================================
+
+
+LIBS += -lm
+
+PROG := ssca2
+
+SRCS += \
+	computeGraph.c \
+	createPartition.c \
+	findSubGraphs.c \
+	genScalData.c \
+	getStartLists.c \
+	getUserParameters.c \
+	globals.c \
+	ssca2.c \
+	$(LIB)/mt19937ar.c \
+	$(LIB)/random.c \
+	$(LIB)/thread.c \
+#
+OBJS := ${SRCS:.c=.o}
+
+
+# ==============================================================================
+#
+# End of Defines.common.mk
+#
+# ==============================================================================
@@ -0,0 +1,513 @@
+/* =============================================================================
+ *
+ * computeGraph.c
+ *
+ * =============================================================================
+ *
+ * Copyright (C) Stanford University, 2006.  All Rights Reserved.
+ * Author: Chi Cao Minh
+ *
+ * =============================================================================
+ *
+ * For the license of bayes/sort.h and bayes/sort.c, please see the header
+ * of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of kmeans, please see kmeans/LICENSE.kmeans
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of ssca2, please see ssca2/COPYRIGHT
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/mt19937ar.c and lib/mt19937ar.h, please see the
+ * header of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/rbtree.h and lib/rbtree.c, please see
+ * lib/LEGALNOTICE.rbtree and lib/LICENSE.rbtree
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * Unless otherwise noted, the following license applies to STAMP files:
+ * 
+ * Copyright (c) 2007, Stanford University
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ * 
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ * 
+ *     * Neither the name of Stanford University nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY STANFORD UNIVERSITY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL STANFORD UNIVERSITY BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * =============================================================================
+ */
+
+
+
+#include <assert.h>
+#include <stdlib.h>
+#include "computeGraph.h"
+#include "createPartition.h"
+#include "defs.h"
+#include "globals.h"
+#include "thread.h"
+#include "tm.h"
+#include "utility.h"
+
+
+static ULONGINT_T*  global_p                 = NULL;
+static ULONGINT_T   global_maxNumVertices    = 0;
+static ULONGINT_T   global_outVertexListSize = 0;
+static ULONGINT_T*  global_impliedEdgeList   = NULL;
+static ULONGINT_T** global_auxArr            = NULL;
+
+
+/* =============================================================================
+ * prefix_sums
+ * -- Exclusive prefix sums of input into result
+ * -- Run by all threads
+ * =============================================================================
+ */
+static void
+prefix_sums (ULONGINT_T* result, LONGINT_T* input, ULONGINT_T arraySize)
+{
+    long myId = thread_getId();
+    long numThread = thread_getNumThread();
+
+    ULONGINT_T* p = NULL;
+    if (myId == 0) {
+        p = (ULONGINT_T*)P_MALLOC(numThread * sizeof(ULONGINT_T));
+        assert(p);
+        global_p = p;
+    }
+
+    thread_barrier_wait();
+
+    p = global_p;
+
+    long start;
+    long end;
+    createPartition(0, arraySize, myId, numThread, &start, &end);
+
+    /* Local sums of each partition */
+    ULONGINT_T sum = 0;
+    long j;
+    for (j = start; j < end; j++) {
+        result[j] = sum;
+        sum += input[j];
+    }
+    p[myId] = sum;
+
+    thread_barrier_wait();
+
+    if (myId == 0) {
+        ULONGINT_T offset = 0;
+        for (j = 0; j < numThread; j++) {
+            ULONGINT_T s = p[j];
+            p[j] = offset;
+            offset += s;
+        }
+    }
+
+    thread_barrier_wait();
+
+    ULONGINT_T add_value = p[myId];
+    for (j = start; j < end; j++) {
+        result[j] += add_value;
+    }
+
+    thread_barrier_wait();
+
+    if (myId == 0) {
+        P_FREE(p);
+    }
+}
+
+
+/* =============================================================================
+ * firstEdgeOf
+ * -- Returns the index of the first edge that starts at vertex v or after it;
+ *    the edge list is sorted by start vertex
+ * =============================================================================
+ */
+static ULONGINT_T
+firstEdgeOf (ULONGINT_T* startVertex, ULONGINT_T numEdge, ULONGINT_T v)
+{
+    ULONGINT_T l = 0;
+    ULONGINT_T h = numEdge;
+
+    while (l < h) {
+        ULONGINT_T m = (l + h) / 2;
+        if (startVertex[m] < v) {
+            l = m + 1;
+        } else {
+            h = m;
+        }
+    }
+
+    return l;
+}
+
+
+/* =============================================================================
+ * computeGraph
+ * -- Kernel 1: builds the adjacency lists of the graph from the edge list
+ * -- Run by all threads
+ * =============================================================================
+ */
+void
+computeGraph (void* argPtr)
+{
+    TM_THREAD_ENTER();
+
+    graph*    GPtr       = ((computeGraph_arg_t*)argPtr)->GPtr;
+    graphSDG* SDGdataPtr = ((computeGraph_arg_t*)argPtr)->SDGdataPtr;
+
+    long myId = thread_getId();
+    long numThread = thread_getNumThread();
+
+    ULONGINT_T j;
+    ULONGINT_T maxNumVertices = 0;
+    ULONGINT_T numEdgesPlaced = SDGdataPtr->numEdgesPlaced;
+
+    /*
+     * First determine the number of vertices by scanning the tuple
+     * startVertex list
+     */
+
+    long i;
+    long i_start;
+    long i_stop;
+    createPartition(0, numEdgesPlaced, myId, numThread, &i_start, &i_stop);
+
+    for (i = i_start; i < i_stop; i++) {
+        if (SDGdataPtr->startVertex[i] + 1 > maxNumVertices) {
+            maxNumVertices = SDGdataPtr->startVertex[i] + 1;
+        }
+        if (SDGdataPtr->endVertex[i] + 1 > maxNumVertices) {
+            maxNumVertices = SDGdataPtr->endVertex[i] + 1;
+        }
+    }
+
+    TM_BEGIN();
+    ULONGINT_T tmp_maxNumVertices = (ULONGINT_T)TM_SHARED_READ(global_maxNumVertices);
+    if (maxNumVertices > tmp_maxNumVertices) {
+        TM_SHARED_WRITE(global_maxNumVertices, maxNumVertices);
+    }
+    TM_END();
+
+    thread_barrier_wait();
+
+    maxNumVertices = global_maxNumVertices;
+
+    if (myId == 0) {
+
+        GPtr->numVertices = maxNumVertices;
+        GPtr->numEdges    = numEdgesPlaced;
+        GPtr->intWeight   = SDGdataPtr->intWeight;
+        GPtr->strWeight   = SDGdataPtr->strWeight;
+
+        /* String weight k is stored as -(k+1), in increasing order of k */
+        GPtr->numStrEdges = 0;
+        GPtr->numIntEdges = numEdgesPlaced;
+        for (i = 0; i < (long)numEdgesPlaced; i++) {
+            if (GPtr->intWeight[numEdgesPlaced-i-1] < 0) {
+                GPtr->numStrEdges = -(GPtr->intWeight[numEdgesPlaced-i-1]);
+                GPtr->numIntEdges = numEdgesPlaced - GPtr->numStrEdges;
+                break;
+            }
+        }
+
+        GPtr->outDegree =
+            (LONGINT_T*)P_MALLOC((GPtr->numVertices) * sizeof(LONGINT_T));
+        assert(GPtr->outDegree);
+
+        GPtr->outVertexIndex =
+            (ULONGINT_T*)P_MALLOC((GPtr->numVertices) * sizeof(ULONGINT_T));
+        assert(GPtr->outVertexIndex);
+    }
+
+    thread_barrier_wait();
+
+    /*
+     * Count the out-edges of each vertex; parallel edges count once
+     */
+
+    createPartition(0, GPtr->numVertices, myId, numThread, &i_start, &i_stop);
+
+    ULONGINT_T outVertexListSize = 0;
+
+    ULONGINT_T i0 = firstEdgeOf(SDGdataPtr->startVertex, numEdgesPlaced, i_start);
+
+    for (i = i_start; i < i_stop; i++) {
+        GPtr->outDegree[i] = 0;
+        GPtr->outVertexIndex[i] = 0;
+        for (j = i0; (j < numEdgesPlaced) && (SDGdataPtr->startVertex[j] == (ULONGINT_T)i); j++) {
+            if ((j == i0) ||
+                (SDGdataPtr->endVertex[j] != SDGdataPtr->endVertex[j-1]))
+            {
+                GPtr->outDegree[i]++;
+                outVertexListSize++;
+            }
+        }
+        i0 = j;
+    }
+
+    thread_barrier_wait();
+
+    prefix_sums(GPtr->outVertexIndex, GPtr->outDegree, GPtr->numVertices);
+
+    TM_BEGIN();
+    TM_SHARED_WRITE(
+        global_outVertexListSize,
+        ((ULONGINT_T)TM_SHARED_READ(global_outVertexListSize) + outVertexListSize)
+    );
+    TM_END();
+
+    thread_barrier_wait();
+
+    outVertexListSize = global_outVertexListSize;
+
+    if (myId == 0) {
+        GPtr->numDirectedEdges = outVertexListSize;
+        GPtr->outVertexList =
+            (ULONGINT_T*)P_MALLOC(outVertexListSize * sizeof(ULONGINT_T));
+        assert(GPtr->outVertexList);
+        GPtr->paralEdgeIndex =
+            (ULONGINT_T*)P_MALLOC(outVertexListSize * sizeof(ULONGINT_T));
+        assert(GPtr->paralEdgeIndex);
+    }
+
+    thread_barrier_wait();
+
+    /*
+     * Evaluate outVertexList; paralEdgeIndex holds the first of the parallel
+     * edges in the edge list
+     */
+
+    i0 = firstEdgeOf(SDGdataPtr->startVertex, numEdgesPlaced, i_start);
+
+    for (i = i_start; i < i_stop; i++) {
+        ULONGINT_T r = GPtr->outVertexIndex[i];
+        for (j = i0; (j < numEdgesPlaced) && (SDGdataPtr->startVertex[j] == (ULONGINT_T)i); j++) {
+            if ((j == i0) ||
+                (SDGdataPtr->endVertex[j] != SDGdataPtr->endVertex[j-1]))
+            {
+                GPtr->paralEdgeIndex[r] = j;
+                GPtr->outVertexList[r] = SDGdataPtr->endVertex[j];
+                r++;
+            }
+        }
+        assert(r == GPtr->outVertexIndex[i] + GPtr->outDegree[i]);
+        i0 = j;
+    }
+
+    thread_barrier_wait();
+
+    if (myId == 0) {
+        P_FREE(SDGdataPtr->startVertex);
+        P_FREE(SDGdataPtr->endVertex);
+        GPtr->inDegree =
+            (LONGINT_T*)P_MALLOC(GPtr->numVertices * sizeof(LONGINT_T));
+        assert(GPtr->inDegree);
+        GPtr->inVertexIndex =
+            (ULONGINT_T*)P_MALLOC(GPtr->numVertices * sizeof(ULONGINT_T));
+        assert(GPtr->inVertexIndex);
+    }
+
+    thread_barrier_wait();
+
+    for (i = i_start; i < i_stop; i++) {
+        GPtr->inDegree[i] = 0;
+        GPtr->inVertexIndex[i] = 0;
+    }
+
+    /* A temp. array to store the implied edges */
+    ULONGINT_T* impliedEdgeList;
+    if (myId == 0) {
+        impliedEdgeList = (ULONGINT_T*)P_MALLOC(GPtr->numVertices
+                                                * MAX_CLUSTER_SIZE
+                                                * sizeof(ULONGINT_T));
+        assert(impliedEdgeList);
+        global_impliedEdgeList = impliedEdgeList;
+    }
+
+    thread_barrier_wait();
+
+    impliedEdgeList = global_impliedEdgeList;
+
+    createPartition(0,
+                    (GPtr->numVertices * MAX_CLUSTER_SIZE),
+                    myId,
+                    numThread,
+                    &i_start,
+                    &i_stop);
+
+    for (i = i_start; i < i_stop; i++) {
+        impliedEdgeList[i] = 0;
+    }
+
+    /*
+     * An auxiliary array to store implied edges, in case we overshoot
+     * MAX_CLUSTER_SIZE
+     */
+
+    ULONGINT_T** auxArr;
+    if (myId == 0) {
+        auxArr = (ULONGINT_T**)P_MALLOC(GPtr->numVertices * sizeof(ULONGINT_T*));
+        assert(auxArr);
+        global_auxArr = auxArr;
+    }
+
+    thread_barrier_wait();
+
+    auxArr = global_auxArr;
+
+    createPartition(0, GPtr->numVertices, myId, numThread, &i_start, &i_stop);
+
+    for (i = i_start; i < i_stop; i++) {
+        auxArr[i] = NULL;
+    }
+
+    thread_barrier_wait();
+
+    for (i = i_start; i < i_stop; i++) {
+        /* Inspect adjacency list of vertex i */
+        for (j = GPtr->outVertexIndex[i];
+             j < (GPtr->outVertexIndex[i] + GPtr->outDegree[i]);
+             j++)
+        {
+            ULONGINT_T v = GPtr->outVertexList[j];
+            ULONGINT_T k;
+            for (k = GPtr->outVertexIndex[v];
+                 k < (GPtr->outVertexIndex[v] + GPtr->outDegree[v]);
+                 k++)
+            {
+                if (GPtr->outVertexList[k] == (ULONGINT_T)i) {
+                    break;
+                }
+            }
+            if (k == GPtr->outVertexIndex[v]+GPtr->outDegree[v]) {
+                TM_BEGIN();
+                /* Add i to the impliedEdgeList of v */
+                long inDegree = (long)TM_SHARED_READ(GPtr->inDegree[v]);
+                TM_SHARED_WRITE(GPtr->inDegree[v], (inDegree + 1));
+                if (inDegree < MAX_CLUSTER_SIZE) {
+                    TM_SHARED_WRITE(impliedEdgeList[v*MAX_CLUSTER_SIZE+inDegree],
+                                    (ULONGINT_T)i);
+                } else {
+                    /*
+                     * Use auxiliary array to store the implied edge; it grows
+                     * by MAX_CLUSTER_SIZE entries at a time
+                     */
+                    long numAux = inDegree - MAX_CLUSTER_SIZE;
+                    ULONGINT_T* a = (ULONGINT_T*)TM_SHARED_READ_P(auxArr[v]);
+                    if ((numAux % MAX_CLUSTER_SIZE) == 0) {
+                        ULONGINT_T* b =
+                            (ULONGINT_T*)TM_MALLOC((numAux + MAX_CLUSTER_SIZE)
+                                                   * sizeof(ULONGINT_T));
+                        assert(b);
+                        long t;
+                        for (t = 0; t < numAux; t++) {
+                            TM_SHARED_WRITE(b[t], (ULONGINT_T)TM_SHARED_READ(a[t]));
+                        }
+                        if (a != NULL) {
+                            TM_FREE(a);
+                        }
+                        TM_SHARED_WRITE_P(auxArr[v], b);
+                        a = b;
+                    }
+                    TM_SHARED_WRITE(a[numAux], (ULONGINT_T)i);
+                }
+                TM_END();
+            }
+        }
+    } /* for i */
+
+    thread_barrier_wait();
+
+    prefix_sums(GPtr->inVertexIndex, GPtr->inDegree, GPtr->numVertices);
+
+    if (myId == 0) {
+        GPtr->numUndirectedEdges = GPtr->inVertexIndex[GPtr->numVertices-1]
+                                   + GPtr->inDegree[GPtr->numVertices-1];
+        GPtr->inVertexList =
+            (ULONGINT_T *)P_MALLOC(MAX(1, GPtr->numUndirectedEdges)
+                                   * sizeof(ULONGINT_T));
+        assert(GPtr->inVertexList);
+    }
+
+    thread_barrier_wait();
+
+    /*
+     * Create the inVertex List
+     */
+
+    for (i = i_start; i < i_stop; i++) {
+        for (j = GPtr->inVertexIndex[i];
+             j < (GPtr->inVertexIndex[i] + GPtr->inDegree[i]);
+             j++)
+        {
+            long r = j - GPtr->inVertexIndex[i];
+            if (r < MAX_CLUSTER_SIZE) {
+                GPtr->inVertexList[j] = impliedEdgeList[i*MAX_CLUSTER_SIZE+r];
+            } else {
+                GPtr->inVertexList[j] = auxArr[i][r - MAX_CLUSTER_SIZE];
+            }
+        }
+    }
+
+    thread_barrier_wait();
+
+    if (myId == 0) {
+        P_FREE(impliedEdgeList);
+    }
+
+    for (i = i_start; i < i_stop; i++) {
+        if (auxArr[i] != NULL) {
+            P_FREE(auxArr[i]);
+        }
+    }
+
+    thread_barrier_wait();
+
+    if (myId == 0) {
+        P_FREE(auxArr);
+    }
+
+    TM_THREAD_EXIT();
+}
+
+
+/* =============================================================================
+ *
+ * End of computeGraph.c
+ *
+ * =============================================================================
+ */
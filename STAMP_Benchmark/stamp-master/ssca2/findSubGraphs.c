@@ -0,0 +1,203 @@
+/* =============================================================================
+ *
+ * findSubGraphs.c
+ *
+ * =============================================================================
+ *
+ * Copyright (C) Stanford University, 2006.  All Rights Reserved.
+ * Author: Chi Cao Minh
+ *
+ * =============================================================================
+ *
+ * For the license of bayes/sort.h and bayes/sort.c, please see the header
+ * of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of kmeans, please see kmeans/LICENSE.kmeans
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of ssca2, please see ssca2/COPYRIGHT
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/mt19937ar.c and lib/mt19937ar.h, please see the
+ * header of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/rbtree.h and lib/rbtree.c, please see
+ * lib/LEGALNOTICE.rbtree and lib/LICENSE.rbtree
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * Unless otherwise noted, the following license applies to STAMP files:
+ * 
+ * Copyright (c) 2007, Stanford University
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ * 
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ * 
+ *     * Neither the name of Stanford University nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY STANFORD UNIVERSITY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL STANFORD UNIVERSITY BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * =============================================================================
+ */
+
+
+
+#include <assert.h>
+#include <stdlib.h>
+#include "createPartition.h"
+#include "defs.h"
+#include "findSubGraphs.h"
+#include "globals.h"
+#include "thread.h"
+#include "tm.h"
+
+
+/* =============================================================================
+ * visit
+ * =============================================================================
+ */
+static void
+visit (ULONGINT_T v, LONGINT_T d,
+       LONGINT_T* depth, ULONGINT_T* queue, ULONGINT_T* tailPtr)
+{
+    if (depth[v] < 0) {
+        depth[v] = d;
+        queue[(*tailPtr)++] = v;
+    }
+}
+
+
+/* =============================================================================
+ * extractSubGraph
+ * -- Breadth first search from the start edge, following out-edges and
+ *    implied in-edges; returns the number of vertices reached
+ * -- depth must be -1 everywhere and is left that way
+ * =============================================================================
+ */
+static ULONGINT_T
+extractSubGraph (graph* GPtr, edge* edgePtr, LONGINT_T* depth, ULONGINT_T* queue)
+{
+    ULONGINT_T head = 0;
+    ULONGINT_T tail = 0;
+
+    visit(edgePtr->startVertex, 0, depth, queue, &tail);
+    visit(edgePtr->endVertex, 1, depth, queue, &tail);
+
+    while (head < tail) {
+        ULONGINT_T u = queue[head++];
+        LONGINT_T d = depth[u];
+        if (d >= SUBGR_PATH_LENGTH) {
+            continue;
+        }
+        ULONGINT_T j;
+        for (j = GPtr->outVertexIndex[u];
+             j < (GPtr->outVertexIndex[u] + GPtr->outDegree[u]);
+             j++)
+        {
+            visit(GPtr->outVertexList[j], (d + 1), depth, queue, &tail);
+        }
+        for (j = GPtr->inVertexIndex[u];
+             j < (GPtr->inVertexIndex[u] + GPtr->inDegree[u]);
+             j++)
+        {
+            visit(GPtr->inVertexList[j], (d + 1), depth, queue, &tail);
+        }
+    }
+
+    for (head = 0; head < tail; head++) {
+        depth[queue[head]] = -1;
+    }
+
+    return tail;
+}
+
+
+/* =============================================================================
+ * findSubGraphs
+ * -- Kernel 3: extracts the subgraph within SUBGR_PATH_LENGTH of each start
+ *    edge found by kernel 2
+ * -- Run by all threads
+ * =============================================================================
+ */
+void
+findSubGraphs (void* argPtr)
+{
+    TM_THREAD_ENTER();
+
+    long myId = thread_getId();
+    long numThread = thread_getNumThread();
+
+    findSubGraphs_arg_t* argsPtr = (findSubGraphs_arg_t*)argPtr;
+    graph* GPtr = argsPtr->GPtr;
+
+    LONGINT_T* depth =
+        (LONGINT_T*)P_MALLOC(GPtr->numVertices * sizeof(LONGINT_T));
+    assert(depth);
+    ULONGINT_T* queue =
+        (ULONGINT_T*)P_MALLOC(GPtr->numVertices * sizeof(ULONGINT_T));
+    assert(queue);
+
+    ULONGINT_T v;
+    for (v = 0; v < GPtr->numVertices; v++) {
+        depth[v] = -1;
+    }
+
+    long i;
+    long i_start;
+    long i_stop;
+
+    createPartition(0, argsPtr->maxIntWtListSize, myId, numThread,
+                    &i_start, &i_stop);
+    for (i = i_start; i < i_stop; i++) {
+        argsPtr->intWtSubGraphSizes[i] =
+            extractSubGraph(GPtr, &argsPtr->maxIntWtList[i], depth, queue);
+    }
+
+    createPartition(0, argsPtr->soughtStrWtListSize, myId, numThread,
+                    &i_start, &i_stop);
+    for (i = i_start; i < i_stop; i++) {
+        argsPtr->strWtSubGraphSizes[i] =
+            extractSubGraph(GPtr, &argsPtr->soughtStrWtList[i], depth, queue);
+    }
+
+    P_FREE(queue);
+    P_FREE(depth);
+
+    TM_THREAD_EXIT();
+}
+
+
+/* =============================================================================
+ *
+ * End of findSubGraphs.c
+ *
+ * =============================================================================
+ */
@@ -0,0 +1,437 @@
+/* =============================================================================
+ *
+ * genScalData.c
+ *
+ * =============================================================================
+ *
+ * Copyright (C) Stanford University, 2006.  All Rights Reserved.
+ * Author: Chi Cao Minh
+ *
+ * =============================================================================
+ *
+ * For the license of bayes/sort.h and bayes/sort.c, please see the header
+ * of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of kmeans, please see kmeans/LICENSE.kmeans
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of ssca2, please see ssca2/COPYRIGHT
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/mt19937ar.c and lib/mt19937ar.h, please see the
+ * header of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/rbtree.h and lib/rbtree.c, please see
+ * lib/LEGALNOTICE.rbtree and lib/LICENSE.rbtree
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * Unless otherwise noted, the following license applies to STAMP files:
+ * 
+ * Copyright (c) 2007, Stanford University
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ * 
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ * 
+ *     * Neither the name of Stanford University nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY STANFORD UNIVERSITY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL STANFORD UNIVERSITY BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * =============================================================================
+ */
+
+
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "createPartition.h"
+#include "defs.h"
+#include "genScalData.h"
+#include "globals.h"
+#include "random.h"
+#include "thread.h"
+#include "tm.h"
+#include "utility.h"
+
+
+typedef struct edgeBuffer {
+    ULONGINT_T* startVertex;
+    ULONGINT_T* endVertex;
+    long size;
+    long capacity;
+} edgeBuffer_t;
+
+
+static ULONGINT_T* global_permV            = NULL;
+static ULONGINT_T* global_firstVsInCliques = NULL;
+static ULONGINT_T* global_lastVsInCliques  = NULL;
+static ULONGINT_T  global_totCliques       = 0;
+static ULONGINT_T  global_edgeNum          = 0;
+
+
+/* =============================================================================
+ * addEdge
+ * -- Appends 'num' parallel edges u->v to a thread-local buffer
+ * =============================================================================
+ */
+static void
+addEdge (edgeBuffer_t* bufferPtr, ULONGINT_T u, ULONGINT_T v, long num)
+{
+    long n;
+
+    for (n = 0; n < num; n++) {
+        if (bufferPtr->size == bufferPtr->capacity) {
+            long capacity = MAX(1024, (2 * bufferPtr->capacity));
+            bufferPtr->startVertex =
+                (ULONGINT_T*)realloc(bufferPtr->startVertex,
+                                     capacity * sizeof(ULONGINT_T));
+            assert(bufferPtr->startVertex);
+            bufferPtr->endVertex =
+                (ULONGINT_T*)realloc(bufferPtr->endVertex,
+                                     capacity * sizeof(ULONGINT_T));
+            assert(bufferPtr->endVertex);
+            bufferPtr->capacity = capacity;
+        }
+        bufferPtr->startVertex[bufferPtr->size] = u;
+        bufferPtr->endVertex[bufferPtr->size] = v;
+        bufferPtr->size++;
+    }
+}
+
+
+/* =============================================================================
+ * findClique
+ * -- Returns the index of the clique that contains vertex v
+ * =============================================================================
+ */
+static ULONGINT_T
+findClique (ULONGINT_T v)
+{
+    ULONGINT_T l = 0;
+    ULONGINT_T h = global_totCliques - 1;
+
+    while (l < h) {
+        ULONGINT_T m = (l + h + 1) / 2;
+        if (global_firstVsInCliques[m] <= v) {
+            l = m;
+        } else {
+            h = m - 1;
+        }
+    }
+
+    assert(v <= global_lastVsInCliques[l]);
+
+    return l;
+}
+
+
+/* =============================================================================
+ * compareEdges
+ * -- For qsort: by start vertex, then by end vertex
+ * =============================================================================
+ */
+static int
+compareEdges (const void* aPtr, const void* bPtr)
+{
+    const edge* a = (const edge*)aPtr;
+    const edge* b = (const edge*)bPtr;
+
+    if (a->startVertex != b->startVertex) {
+        return ((a->startVertex < b->startVertex) ? -1 : 1);
+    }
+    if (a->endVertex != b->endVertex) {
+        return ((a->endVertex < b->endVertex) ? -1 : 1);
+    }
+
+    return 0;
+}
+
+
+/* =============================================================================
+ * genScalData
+ * -- Generates the edge list of the graph into the graphSDG at argPtr
+ * -- Run by all threads
+ * =============================================================================
+ */
+void
+genScalData (void* argPtr)
+{
+    TM_THREAD_ENTER();
+
+    graphSDG* SDGdataPtr = (graphSDG*)argPtr;
+
+    long myId = thread_getId();
+    long numThread = thread_getNumThread();
+
+    random_t* stream = PRANDOM_ALLOC();
+    assert(stream);
+    PRANDOM_SEED(stream, myId);
+
+    long i;
+    long i_start;
+    long i_stop;
+
+    /*
+     * STEP 0: Create the permutations required to randomize the vertices
+     */
+
+    ULONGINT_T* permV;
+    if (myId == 0) {
+        permV = (ULONGINT_T*)P_MALLOC(TOT_VERTICES * sizeof(ULONGINT_T));
+        assert(permV);
+        global_permV = permV;
+        global_edgeNum = 0;
+    }
+
+    thread_barrier_wait();
+
+    permV = global_permV;
+
+    createPartition(0, TOT_VERTICES, myId, numThread, &i_start, &i_stop);
+
+    /* Initialize the array */
+    for (i = i_start; i < i_stop; i++) {
+        permV[i] = i;
+    }
+
+    thread_barrier_wait();
+
+    for (i = i_start; i < i_stop; i++) {
+        ULONGINT_T t1 = PRANDOM_GENERATE(stream);
+        ULONGINT_T t = i + t1 % (TOT_VERTICES - i);
+        if (t != (ULONGINT_T)i) {
+            TM_BEGIN();
+            ULONGINT_T t2 = (ULONGINT_T)TM_SHARED_READ(permV[t]);
+            TM_SHARED_WRITE(permV[t], (ULONGINT_T)TM_SHARED_READ(permV[i]));
+            TM_SHARED_WRITE(permV[i], t2);
+            TM_END();
+        }
+    }
+
+    /*
+     * STEP 1: Create Cliques
+     */
+
+    if (myId == 0) {
+        /* Every clique has at least one vertex */
+        ULONGINT_T* firstVsInCliques =
+            (ULONGINT_T*)P_MALLOC(TOT_VERTICES * sizeof(ULONGINT_T));
+        assert(firstVsInCliques);
+        ULONGINT_T* lastVsInCliques =
+            (ULONGINT_T*)P_MALLOC(TOT_VERTICES * sizeof(ULONGINT_T));
+        assert(lastVsInCliques);
+
+        ULONGINT_T totCliques = 0;
+        ULONGINT_T numVertices = 0;
+        while (numVertices < TOT_VERTICES) {
+            ULONGINT_T size = 1 + PRANDOM_GENERATE(stream) % MAX_CLIQUE_SIZE;
+            size = MIN(size, (TOT_VERTICES - numVertices));
+            firstVsInCliques[totCliques] = numVertices;
+            numVertices += size;
+            lastVsInCliques[totCliques] = numVertices - 1;
+            totCliques++;
+        }
+
+        global_firstVsInCliques = firstVsInCliques;
+        global_lastVsInCliques  = lastVsInCliques;
+        global_totCliques       = totCliques;
+    }
+
+    thread_barrier_wait();
+
+    ULONGINT_T* firstVsInCliques = global_firstVsInCliques;
+    ULONGINT_T* lastVsInCliques  = global_lastVsInCliques;
+    ULONGINT_T  totCliques       = global_totCliques;
+
+    edgeBuffer_t buffer;
+    buffer.startVertex = NULL;
+    buffer.endVertex   = NULL;
+    buffer.size        = 0;
+    buffer.capacity    = 0;
+
+    /*
+     * STEP 2: Create the edges within cliques
+     */
+
+    createPartition(0, totCliques, myId, numThread, &i_start, &i_stop);
+
+    for (i = i_start; i < i_stop; i++) {
+        ULONGINT_T j;
+        for (j = firstVsInCliques[i]; j <= lastVsInCliques[i]; j++) {
+            ULONGINT_T k;
+            for (k = j+1; k <= lastVsInCliques[i]; k++) {
+                long numParalEdges = (PRANDOM_GENERATE(stream) % MAX_PARAL_EDGES) + 1;
+                addEdge(&buffer, j, k, numParalEdges);
+                double r = (double)(PRANDOM_GENERATE(stream) % 1000) / 1000.0;
+                if (r >= PROB_UNIDIRECTIONAL) {
+                    addEdge(&buffer, k, j, numParalEdges);
+                }
+            }
+        }
+    }
+
+    /*
+     * STEP 3: Create the edges between cliques, at power-of-two distances
+     * with a probability that halves with the distance
+     */
+
+    createPartition(0, TOT_VERTICES, myId, numThread, &i_start, &i_stop);
+
+    for (i = i_start; i < i_stop; i++) {
+        ULONGINT_T c = findClique(i);
+        ULONGINT_T d;
+        double p;
+        for (d = 1, p = PROB_INTERCL_EDGES; d < TOT_VERTICES; d *= 2, p /= 2) {
+            double r = (double)(PRANDOM_GENERATE(stream) % 1000) / 1000.0;
+            if (r <= p) {
+                ULONGINT_T j = (i + d) % TOT_VERTICES;
+                if (findClique(j) != c) {
+                    long numParalEdges = (PRANDOM_GENERATE(stream) % MAX_PARAL_EDGES) + 1;
+                    addEdge(&buffer, i, j, numParalEdges);
+                }
+            }
+        }
+    }
+
+    /*
+     * Claim a range of the edge arrays for the local edges
+     */
+
+    ULONGINT_T offset;
+    TM_BEGIN();
+    offset = (ULONGINT_T)TM_SHARED_READ(global_edgeNum);
+    TM_SHARED_WRITE(global_edgeNum, (offset + buffer.size));
+    TM_END();
+
+    thread_barrier_wait();
+
+    if (myId == 0) {
+        SDGdataPtr->numEdgesPlaced = global_edgeNum;
+        SDGdataPtr->startVertex =
+            (ULONGINT_T*)P_MALLOC(global_edgeNum * sizeof(ULONGINT_T));
+        assert(SDGdataPtr->startVertex);
+        SDGdataPtr->endVertex =
+            (ULONGINT_T*)P_MALLOC(global_edgeNum * sizeof(ULONGINT_T));
+        assert(SDGdataPtr->endVertex);
+    }
+
+    thread_barrier_wait();
+
+    /* Relabel the vertices with the permutation */
+    for (i = 0; i < buffer.size; i++) {
+        SDGdataPtr->startVertex[offset+i] = permV[buffer.startVertex[i]];
+        SDGdataPtr->endVertex[offset+i]   = permV[buffer.endVertex[i]];
+    }
+    free(buffer.startVertex);
+    free(buffer.endVertex);
+
+    thread_barrier_wait();
+
+    if (myId == 0) {
+
+        ULONGINT_T numEdgesPlaced = SDGdataPtr->numEdgesPlaced;
+
+        /*
+         * STEP 4: Sort the edges by start vertex, then by end vertex
+         */
+
+        edge* edges = (edge*)P_MALLOC(numEdgesPlaced * sizeof(edge));
+        assert(edges);
+        for (i = 0; i < (long)numEdgesPlaced; i++) {
+            edges[i].startVertex = SDGdataPtr->startVertex[i];
+            edges[i].endVertex   = SDGdataPtr->endVertex[i];
+            edges[i].edgeNum     = i;
+        }
+        qsort(edges, numEdgesPlaced, sizeof(edge), &compareEdges);
+        for (i = 0; i < (long)numEdgesPlaced; i++) {
+            SDGdataPtr->startVertex[i] = edges[i].startVertex;
+            SDGdataPtr->endVertex[i]   = edges[i].endVertex;
+        }
+        P_FREE(edges);
+
+        /*
+         * STEP 5: Assign weights; string weight k is stored as -(k+1)
+         */
+
+        SDGdataPtr->intWeight =
+            (LONGINT_T*)P_MALLOC(numEdgesPlaced * sizeof(LONGINT_T));
+        assert(SDGdataPtr->intWeight);
+        ULONGINT_T numStrWtEdges = 0;
+        for (i = 0; i < (long)numEdgesPlaced; i++) {
+            double r = (double)(PRANDOM_GENERATE(stream) % 1000) / 1000.0;
+            if (r <= PERC_INT_WEIGHTS) {
+                SDGdataPtr->intWeight[i] =
+                    (PRANDOM_GENERATE(stream) % (MAX_INT_WEIGHT-1)) + 1;
+            } else {
+                numStrWtEdges++;
+                SDGdataPtr->intWeight[i] = -(LONGINT_T)numStrWtEdges;
+            }
+        }
+
+        SDGdataPtr->strWeight =
+            (char*)P_MALLOC(MAX(1, numStrWtEdges * MAX_STRLEN) * sizeof(char));
+        assert(SDGdataPtr->strWeight);
+        for (i = 0; i < (long)(numStrWtEdges * MAX_STRLEN); i++) {
+            SDGdataPtr->strWeight[i] = (char)('a' + PRANDOM_GENERATE(stream) % 26);
+        }
+
+        /* Choose the string sought by kernel 2 */
+        SOUGHT_STRING = (char*)P_MALLOC((MAX_STRLEN + 1) * sizeof(char));
+        assert(SOUGHT_STRING);
+        memset(SOUGHT_STRING, 0, (MAX_STRLEN + 1) * sizeof(char));
+        if (numStrWtEdges > 0) {
+            ULONGINT_T t = PRANDOM_GENERATE(stream) % numStrWtEdges;
+            memcpy(SOUGHT_STRING,
+                   &SDGdataPtr->strWeight[t * MAX_STRLEN],
+                   MAX_STRLEN * sizeof(char));
+        }
+
+        P_FREE(permV);
+        P_FREE(firstVsInCliques);
+        P_FREE(lastVsInCliques);
+    }
+
+    thread_barrier_wait();
+
+    PRANDOM_FREE(stream);
+
+    TM_THREAD_EXIT();
+}
+
+
+/* =============================================================================
+ *
+ * End of genScalData.c
+ *
+ * =============================================================================
+ */
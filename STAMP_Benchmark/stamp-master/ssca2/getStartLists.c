@@ -0,0 +1,289 @@
+/* =============================================================================
+ *
+ * getStartLists.c
+ *
+ * =============================================================================
+ *
+ * Copyright (C) Stanford University, 2006.  All Rights Reserved.
+ * Author: Chi Cao Minh
+ *
+ * =============================================================================
+ *
+ * For the license of bayes/sort.h and bayes/sort.c, please see the header
+ * of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of kmeans, please see kmeans/LICENSE.kmeans
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of ssca2, please see ssca2/COPYRIGHT
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/mt19937ar.c and lib/mt19937ar.h, please see the
+ * header of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/rbtree.h and lib/rbtree.c, please see
+ * lib/LEGALNOTICE.rbtree and lib/LICENSE.rbtree
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * Unless otherwise noted, the following license applies to STAMP files:
+ * 
+ * Copyright (c) 2007, Stanford University
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ * 
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ * 
+ *     * Neither the name of Stanford University nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY STANFORD UNIVERSITY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL STANFORD UNIVERSITY BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * =============================================================================
+ */
+
+
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "createPartition.h"
+#include "defs.h"
+#include "getStartLists.h"
+#include "globals.h"
+#include "thread.h"
+#include "tm.h"
+#include "utility.h"
+
+
+typedef struct edgeList {
+    edge* edges;
+    long size;
+    long capacity;
+} edgeList_t;
+
+
+static LONGINT_T global_maxWeight           = 0;
+static long      global_maxIntWtListSize    = 0;
+static long      global_soughtStrWtListSize = 0;
+static edge*     global_maxIntWtList        = NULL;
+static edge*     global_soughtStrWtList     = NULL;
+
+
+/* =============================================================================
+ * findEdge
+ * -- Fills in the start vertex, end vertex and directed edge number of the
+ *    edge at index e of the edge list
+ * =============================================================================
+ */
+static void
+findEdge (graph* GPtr, ULONGINT_T e, edge* edgePtr)
+{
+    ULONGINT_T l;
+    ULONGINT_T h;
+
+    /* Last directed edge whose first parallel edge is at or before e */
+    l = 0;
+    h = GPtr->numDirectedEdges - 1;
+    while (l < h) {
+        ULONGINT_T m = (l + h + 1) / 2;
+        if (GPtr->paralEdgeIndex[m] <= e) {
+            l = m;
+        } else {
+            h = m - 1;
+        }
+    }
+    edgePtr->edgeNum = l;
+    edgePtr->endVertex = GPtr->outVertexList[l];
+
+    /* Last vertex whose out-edges start at or before that directed edge */
+    ULONGINT_T j = l;
+    l = 0;
+    h = GPtr->numVertices - 1;
+    while (l < h) {
+        ULONGINT_T m = (l + h + 1) / 2;
+        if (GPtr->outVertexIndex[m] <= j) {
+            l = m;
+        } else {
+            h = m - 1;
+        }
+    }
+    edgePtr->startVertex = l;
+}
+
+
+/* =============================================================================
+ * appendEdge
+ * =============================================================================
+ */
+static void
+appendEdge (edgeList_t* listPtr, graph* GPtr, ULONGINT_T e)
+{
+    if (listPtr->size == listPtr->capacity) {
+        long capacity = MAX(16, (2 * listPtr->capacity));
+        listPtr->edges = (edge*)realloc(listPtr->edges, capacity * sizeof(edge));
+        assert(listPtr->edges);
+        listPtr->capacity = capacity;
+    }
+    findEdge(GPtr, e, &listPtr->edges[listPtr->size]);
+    listPtr->size++;
+}
+
+
+/* =============================================================================
+ * getStartLists
+ * -- Kernel 2: lists the edges with the largest integer weight and the edges
+ *    whose string weight is SOUGHT_STRING
+ * -- Run by all threads
+ * =============================================================================
+ */
+void
+getStartLists (void* argPtr)
+{
+    TM_THREAD_ENTER();
+
+    long myId = thread_getId();
+    long numThread = thread_getNumThread();
+
+    graph* GPtr = ((getStartLists_arg_t*)argPtr)->GPtr;
+    edge** maxIntWtListPtr = ((getStartLists_arg_t*)argPtr)->maxIntWtListPtr;
+    long*  maxIntWtListSize = ((getStartLists_arg_t*)argPtr)->maxIntWtListSize;
+    edge** soughtStrWtListPtr = ((getStartLists_arg_t*)argPtr)->soughtStrWtListPtr;
+    long*  soughtStrWtListSize = ((getStartLists_arg_t*)argPtr)->soughtStrWtListSize;
+
+    long i;
+    long i_start;
+    long i_stop;
+
+    /*
+     * Find Max Wt on each thread
+     */
+
+    LONGINT_T maxWeight = 0;
+
+    createPartition(0, GPtr->numEdges, myId, numThread, &i_start, &i_stop);
+
+    for (i = i_start; i < i_stop; i++) {
+        if (GPtr->intWeight[i] > maxWeight) {
+            maxWeight = GPtr->intWeight[i];
+        }
+    }
+
+    TM_BEGIN();
+    long tmp_maxWeight = (long)TM_SHARED_READ(global_maxWeight);
+    if (maxWeight > tmp_maxWeight) {
+        TM_SHARED_WRITE(global_maxWeight, maxWeight);
+    }
+    TM_END();
+
+    thread_barrier_wait();
+
+    maxWeight = global_maxWeight;
+
+    /*
+     * Create partial lists
+     */
+
+    edgeList_t intWtList;
+    intWtList.edges = NULL;
+    intWtList.size = 0;
+    intWtList.capacity = 0;
+
+    edgeList_t strWtList;
+    strWtList.edges = NULL;
+    strWtList.size = 0;
+    strWtList.capacity = 0;
+
+    for (i = i_start; i < i_stop; i++) {
+        LONGINT_T w = GPtr->intWeight[i];
+        if (w == maxWeight) {
+            appendEdge(&intWtList, GPtr, i);
+        } else if (w < 0) {
+            char* str = &GPtr->strWeight[(-w - 1) * MAX_STRLEN];
+            if (strncmp(str, SOUGHT_STRING, MAX_STRLEN) == 0) {
+                appendEdge(&strWtList, GPtr, i);
+            }
+        }
+    }
+
+    /*
+     * Merge partial edge lists: claim a range of each list
+     */
+
+    long intWtOffset;
+    long strWtOffset;
+    TM_BEGIN();
+    intWtOffset = (long)TM_SHARED_READ(global_maxIntWtListSize);
+    TM_SHARED_WRITE(global_maxIntWtListSize, (intWtOffset + intWtList.size));
+    strWtOffset = (long)TM_SHARED_READ(global_soughtStrWtListSize);
+    TM_SHARED_WRITE(global_soughtStrWtListSize, (strWtOffset + strWtList.size));
+    TM_END();
+
+    thread_barrier_wait();
+
+    if (myId == 0) {
+        *maxIntWtListSize = global_maxIntWtListSize;
+        global_maxIntWtList =
+            (edge*)P_MALLOC(MAX(1, global_maxIntWtListSize) * sizeof(edge));
+        assert(global_maxIntWtList);
+        *maxIntWtListPtr = global_maxIntWtList;
+        *soughtStrWtListSize = global_soughtStrWtListSize;
+        global_soughtStrWtList =
+            (edge*)P_MALLOC(MAX(1, global_soughtStrWtListSize) * sizeof(edge));
+        assert(global_soughtStrWtList);
+        *soughtStrWtListPtr = global_soughtStrWtList;
+    }
+
+    thread_barrier_wait();
+
+    if (intWtList.size > 0) {
+        memcpy(&global_maxIntWtList[intWtOffset],
+               intWtList.edges,
+               intWtList.size * sizeof(edge));
+    }
+    if (strWtList.size > 0) {
+        memcpy(&global_soughtStrWtList[strWtOffset],
+               strWtList.edges,
+               strWtList.size * sizeof(edge));
+    }
+    free(intWtList.edges);
+    free(strWtList.edges);
+
+    thread_barrier_wait();
+
+    TM_THREAD_EXIT();
+}
+
+
+/* =============================================================================
+ *
+ * End of getStartLists.c
+ *
+ * =============================================================================
+ */
@@ -0,0 +1,314 @@
+/* =============================================================================
+ *
+ * ssca2.c
+ *
+ * =============================================================================
+ *
+ * Copyright (C) Stanford University, 2006.  All Rights Reserved.
+ * Author: Chi Cao Minh
+ *
+ * =============================================================================
+ *
+ * For the license of bayes/sort.h and bayes/sort.c, please see the header
+ * of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of kmeans, please see kmeans/LICENSE.kmeans
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of ssca2, please see ssca2/COPYRIGHT
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/mt19937ar.c and lib/mt19937ar.h, please see the
+ * header of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/rbtree.h and lib/rbtree.c, please see
+ * lib/LEGALNOTICE.rbtree and lib/LICENSE.rbtree
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * Unless otherwise noted, the following license applies to STAMP files:
+ * 
+ * Copyright (c) 2007, Stanford University
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ * 
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ * 
+ *     * Neither the name of Stanford University nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY STANFORD UNIVERSITY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL STANFORD UNIVERSITY BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * =============================================================================
+ */
+
+
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "computeGraph.h"
+#include "defs.h"
+#include "findSubGraphs.h"
+#include "genScalData.h"
+#include "getStartLists.h"
+#include "getUserParameters.h"
+#include "globals.h"
+#include "thread.h"
+#include "timer.h"
+#include "tm.h"
+#include "utility.h"
+
+
+MAIN(argc, argv)
+{
+    GOTO_REAL();
+
+    /*
+     * Tuple for Scalable Data Generation
+     * stores startVertex, endVertex, long weight and other info
+     */
+    graphSDG* SDGdata;
+
+    /*
+     * The graph data structure for this benchmark - see defs.h
+     */
+    graph* G;
+
+    /*
+     * Kernel 2 output: the start edges of kernel 3
+     */
+    edge* maxIntWtList;
+    edge* soughtStrWtList;
+    long maxIntWtListSize;
+    long soughtStrWtListSize;
+
+    double totalTime = 0.0;
+
+    /* -------------------------------------------------------------------------
+     * Preamble
+     * -------------------------------------------------------------------------
+     */
+
+    /*
+     * User Interface: Configurable parameters, and global program control
+     */
+
+    getUserParameters(argc, (char** const)argv);
+
+    SIM_GET_NUM_CPU(THREADS);
+    TM_STARTUP(THREADS);
+    P_MEMORY_STARTUP(THREADS);
+    thread_startup(THREADS);
+
+    puts("");
+    printf("Number of processors:       %ld\n", THREADS);
+    printf("Problem Scale:              %lf\n", SCALE);
+    printf("Max parallel edges:         %ld\n", MAX_PARAL_EDGES);
+    printf("Percent int weights:        %lf\n", PERC_INT_WEIGHTS);
+    printf("Probability unidirectional: %lf\n", PROB_UNIDIRECTIONAL);
+    printf("Probability inter-clique:   %lf\n", PROB_INTERCL_EDGES);
+    printf("Subgraph edge length:       %ld\n", SUBGR_PATH_LENGTH);
+    puts("");
+
+    /*
+     * Scalable Data Generator
+     */
+
+    printf("\nScalable Data Generator - genScalData() beginning execution...\n");
+
+    SDGdata = (graphSDG*)malloc(sizeof(graphSDG));
+    assert(SDGdata);
+
+    TIMER_T start;
+    TIMER_READ(start);
+
+    GOTO_SIM();
+    thread_start(genScalData, (void*)SDGdata);
+    GOTO_REAL();
+
+    TIMER_T stop;
+    TIMER_READ(stop);
+
+    double time = TIMER_DIFF_SECONDS(start, stop);
+    printf("\nTime taken for Scalable Data Generation is %9.6f sec.\n\n", time);
+    printf("\n\tgenScalData() completed execution.\n");
+
+    /* -------------------------------------------------------------------------
+     * Kernel 1 - Graph Construction
+     *
+     * From the tuple list, construct the graph as an adjacency list
+     * -------------------------------------------------------------------------
+     */
+
+    printf("\nKernel 1 - computeGraph() beginning execution...\n");
+
+    G = (graph*)malloc(sizeof(graph));
+    assert(G);
+
+    computeGraph_arg_t computeGraphArgs;
+    computeGraphArgs.GPtr       = G;
+    computeGraphArgs.SDGdataPtr = SDGdata;
+
+    TIMER_READ(start);
+
+    GOTO_SIM();
+    thread_start(computeGraph, (void*)&computeGraphArgs);
+    GOTO_REAL();
+
+    TIMER_READ(stop);
+
+    time = TIMER_DIFF_SECONDS(start, stop);
+    totalTime += time;
+
+    printf("\n\tcomputeGraph() completed execution.\n");
+    printf("\nTime taken for kernel 1 is %9.6f sec.\n", time);
+    printf("Vertices: %lu, edges: %lu (%lu directed, %lu with implied in-edges)\n",
+           G->numVertices, G->numEdges,
+           G->numDirectedEdges, G->numUndirectedEdges);
+
+    /* -------------------------------------------------------------------------
+     * Kernel 2 - Find Max weight and sought string
+     * -------------------------------------------------------------------------
+     */
+
+    printf("\nKernel 2 - getStartLists() beginning execution...\n");
+
+    maxIntWtListSize = 0;
+    soughtStrWtListSize = 0;
+
+    getStartLists_arg_t getStartListsArg;
+    getStartListsArg.GPtr                = G;
+    getStartListsArg.maxIntWtListPtr     = &maxIntWtList;
+    getStartListsArg.maxIntWtListSize    = &maxIntWtListSize;
+    getStartListsArg.soughtStrWtListPtr  = &soughtStrWtList;
+    getStartListsArg.soughtStrWtListSize = &soughtStrWtListSize;
+
+    TIMER_READ(start);
+
+    GOTO_SIM();
+    thread_start(getStartLists, (void*)&getStartListsArg);
+    GOTO_REAL();
+
+    TIMER_READ(stop);
+
+    time = TIMER_DIFF_SECONDS(start, stop);
+    totalTime += time;
+
+    printf("\n\tgetStartLists() completed execution.\n");
+    printf("\nTime taken for kernel 2 is %9.6f sec.\n", time);
+    printf("Max weight edges: %ld, sought string edges: %ld\n",
+           maxIntWtListSize, soughtStrWtListSize);
+
+    /* -------------------------------------------------------------------------
+     * Kernel 3 - Graph Extraction
+     * -------------------------------------------------------------------------
+     */
+
+    printf("\nKernel 3 - findSubGraphs() beginning execution...\n");
+
+    findSubGraphs_arg_t findSubGraphsArg;
+    findSubGraphsArg.GPtr                = G;
+    findSubGraphsArg.maxIntWtList        = maxIntWtList;
+    findSubGraphsArg.maxIntWtListSize    = maxIntWtListSize;
+    findSubGraphsArg.soughtStrWtList     = soughtStrWtList;
+    findSubGraphsArg.soughtStrWtListSize = soughtStrWtListSize;
+    findSubGraphsArg.intWtSubGraphSizes  =
+        (ULONGINT_T*)malloc(MAX(1, maxIntWtListSize) * sizeof(ULONGINT_T));
+    assert(findSubGraphsArg.intWtSubGraphSizes);
+    findSubGraphsArg.strWtSubGraphSizes  =
+        (ULONGINT_T*)malloc(MAX(1, soughtStrWtListSize) * sizeof(ULONGINT_T));
+    assert(findSubGraphsArg.strWtSubGraphSizes);
+
+    TIMER_READ(start);
+
+    GOTO_SIM();
+    thread_start(findSubGraphs, (void*)&findSubGraphsArg);
+    GOTO_REAL();
+
+    TIMER_READ(stop);
+
+    time = TIMER_DIFF_SECONDS(start, stop);
+    totalTime += time;
+
+    printf("\n\tfindSubGraphs() completed execution.\n");
+    printf("\nTime taken for kernel 3 is %9.6f sec.\n\n", time);
+
+    ULONGINT_T numSubGraphVertex = 0;
+    long i;
+    for (i = 0; i < maxIntWtListSize; i++) {
+        numSubGraphVertex += findSubGraphsArg.intWtSubGraphSizes[i];
+    }
+    for (i = 0; i < soughtStrWtListSize; i++) {
+        numSubGraphVertex += findSubGraphsArg.strWtSubGraphSizes[i];
+    }
+    printf("Subgraphs: %ld, vertices in subgraphs: %lu\n",
+           (maxIntWtListSize + soughtStrWtListSize), numSubGraphVertex);
+
+    printf("\nTime taken for all is %9.6f sec.\n\n", totalTime);
+
+    /* -------------------------------------------------------------------------
+     * Cleanup
+     * -------------------------------------------------------------------------
+     */
+
+    P_FREE(G->outDegree);
+    P_FREE(G->outVertexIndex);
+    P_FREE(G->outVertexList);
+    P_FREE(G->paralEdgeIndex);
+    P_FREE(G->inDegree);
+    P_FREE(G->inVertexIndex);
+    P_FREE(G->inVertexList);
+    P_FREE(G->intWeight);
+    P_FREE(G->strWeight);
+    P_FREE(SOUGHT_STRING);
+    P_FREE(maxIntWtList);
+    P_FREE(soughtStrWtList);
+    free(findSubGraphsArg.intWtSubGraphSizes);
+    free(findSubGraphsArg.strWtSubGraphSizes);
+    free(G);
+    free(SDGdata);
+
+    TM_SHUTDOWN();
+    P_MEMORY_SHUTDOWN();
+
+    GOTO_SIM();
+
+    thread_shutdown();
+
+    MAIN_RETURN(0);
+}
+
+
+/* =============================================================================
+ *
+ * End of ssca2.c
+ *
+ * =============================================================================
+ */
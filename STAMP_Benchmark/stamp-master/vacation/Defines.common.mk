@@ -0,0 +1,33 @@
+# ==============================================================================
+#
+# Defines.common.mk
+#
+# ==============================================================================
+
+
+PROG := vacation
+
+SRCS += \
+	client.c \
+	customer.c \
+	manager.c \
+	reservation.c \
+	vacation.c \
+	$(LIB)/list.c \
+	$(LIB)/pair.c \
+	$(LIB)/mt19937ar.c \
+	$(LIB)/random.c \
+	$(LIB)/rbtree.c \
+	$(LIB)/thread.c \
+#
+OBJS := ${SRCS:.c=.o}
+
+CFLAGS += -DLIST_NO_DUPLICATES
+CFLAGS += -DMAP_USE_RBTREE
+
+
+# ==============================================================================
+#
+# End of Defines.common.mk
+#
+# ==============================================================================
@@ -0,0 +1,729 @@
+/* =============================================================================
+ *
+ * element.c
+ *
+ * =============================================================================
+ *
+ * Copyright (C) Stanford University, 2006.  All Rights Reserved.
+ * Author: Chi Cao Minh
+ *
+ * =============================================================================
+ *
+ * For the license of bayes/sort.h and bayes/sort.c, please see the header
+ * of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of kmeans, please see kmeans/LICENSE.kmeans
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of ssca2, please see ssca2/COPYRIGHT
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/mt19937ar.c and lib/mt19937ar.h, please see the
+ * header of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/rbtree.h and lib/rbtree.c, please see
+ * lib/LEGALNOTICE.rbtree and lib/LICENSE.rbtree
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * Unless otherwise noted, the following license applies to STAMP files:
+ * 
+ * Copyright (c) 2007, Stanford University
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ * 
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ * 
+ *     * Neither the name of Stanford University nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY STANFORD UNIVERSITY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL STANFORD UNIVERSITY BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * =============================================================================
+ */
+
+
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include "coordinate.h"
+#include "element.h"
+#include "list.h"
+#include "pair.h"
+#include "tm.h"
+#include "types.h"
+#include "yada.h"
+
+
+/* =============================================================================
+ * minimizeCoordinates
+ * -- Put smallest coordinate in position 0
+ * =============================================================================
+ */
+static void
+minimizeCoordinates (element_t* elementPtr)
+{
+    long i;
+    coordinate_t* coordinates = elementPtr->coordinates;
+    long numCoordinate = elementPtr->numCoordinate;
+    long minPosition = 0;
+
+    for (i = 1; i < numCoordinate; i++) {
+        if (coordinate_compare(&coordinates[i], &coordinates[minPosition]) < 0) {
+            minPosition = i;
+        }
+    }
+
+    while (minPosition != 0) {
+        coordinate_t tmp = coordinates[0];
+        long j;
+        for (j = 0; j < (numCoordinate - 1); j++) {
+            coordinates[j] = coordinates[j+1];
+        }
+        coordinates[numCoordinate-1] = tmp;
+        minPosition--;
+    }
+}
+
+
+/* =============================================================================
+ * checkAngles
+ * -- Sets isSkinny to TRUE if the angle constraint is not met
+ * =============================================================================
+ */
+static void
+checkAngles (element_t* elementPtr)
+{
+    long numCoordinate = elementPtr->numCoordinate;
+    double angleConstraint = global_angleConstraint;
+    double minAngle = 180.0;
+
+    assert(numCoordinate == 2 || numCoordinate == 3);
+    elementPtr->isReferenced = FALSE;
+    elementPtr->isSkinny = FALSE;
+    elementPtr->encroachedEdgePtr = NULL;
+
+    if (numCoordinate == 3) {
+        long i;
+        coordinate_t* coordinates = elementPtr->coordinates;
+        for (i = 0; i < 3; i++) {
+            double angle = coordinate_angle(&coordinates[i],
+                                            &coordinates[(i + 1) % 3],
+                                            &coordinates[(i + 2) % 3]);
+            assert(angle > 0.0);
+            assert(angle < 180.0);
+            if (angle > 90.0) {
+                elementPtr->encroachedEdgePtr = &elementPtr->edges[(i + 1) % 3];
+            }
+            if (angle < angleConstraint) {
+                elementPtr->isSkinny = TRUE;
+            }
+            if (angle < minAngle) {
+                minAngle = angle;
+            }
+        }
+        assert(minAngle < 180.0);
+    }
+
+    elementPtr->minAngle = minAngle;
+}
+
+
+/* =============================================================================
+ * calculateCircumCircle
+ * -- Sets circumCenter and circumRadius
+ * =============================================================================
+ */
+static void
+calculateCircumCircle (element_t* elementPtr)
+{
+    long numCoordinate = elementPtr->numCoordinate;
+    coordinate_t* coordinates = elementPtr->coordinates;
+    coordinate_t* circumCenterPtr = &elementPtr->circumCenter;
+
+    assert(numCoordinate == 2 || numCoordinate == 3);
+
+    if (numCoordinate == 2) {
+        circumCenterPtr->x = (coordinates[0].x + coordinates[1].x) / 2.0;
+        circumCenterPtr->y = (coordinates[0].y + coordinates[1].y) / 2.0;
+    } else {
+        double ax = coordinates[0].x;
+        double ay = coordinates[0].y;
+        double bx = coordinates[1].x;
+        double by = coordinates[1].y;
+        double cx = coordinates[2].x;
+        double cy = coordinates[2].y;
+        double bxDelta = bx - ax;
+        double byDelta = by - ay;
+        double cxDelta = cx - ax;
+        double cyDelta = cy - ay;
+        double bDistance2 = (bxDelta * bxDelta) + (byDelta * byDelta);
+        double cDistance2 = (cxDelta * cxDelta) + (cyDelta * cyDelta);
+        double xNumerator = (byDelta * cDistance2) - (cyDelta * bDistance2);
+        double yNumerator = (bxDelta * cDistance2) - (cxDelta * bDistance2);
+        double denominator = 2 * ((bxDelta * cyDelta) - (cxDelta * byDelta));
+        assert(fabs(denominator) > 0.0); /* make sure not colinear */
+        double rx = ax - (xNumerator / denominator);
+        double ry = ay + (yNumerator / denominator);
+        circumCenterPtr->x = rx;
+        circumCenterPtr->y = ry;
+    }
+
+    elementPtr->circumRadius = coordinate_distance(circumCenterPtr,
+                                                   &coordinates[0]);
+}
+
+
+/* =============================================================================
+ * setEdge
+ * -- Note: Makes pairPtr sorted; i.e., coordinate_compare(first, second) < 0
+ * =============================================================================
+ */
+static void
+setEdge (element_t* elementPtr, long i)
+{
+    long numCoordinate = elementPtr->numCoordinate;
+    coordinate_t* coordinates = elementPtr->coordinates;
+
+    coordinate_t* firstPtr = &coordinates[i];
+    coordinate_t* secondPtr = &coordinates[(i + 1) % numCoordinate];
+
+    edge_t* edgePtr = &elementPtr->edges[i];
+
+    long cmp = coordinate_compare(firstPtr, secondPtr);
+    assert(cmp != 0);
+    if (cmp < 0) {
+        edgePtr->firstPtr  = (void*)firstPtr;
+        edgePtr->secondPtr = (void*)secondPtr;
+    } else {
+        edgePtr->firstPtr  = (void*)secondPtr;
+        edgePtr->secondPtr = (void*)firstPtr;
+    }
+
+    coordinate_t* midpointPtr = &elementPtr->midpoints[i];
+    midpointPtr->x = (firstPtr->x + secondPtr->x) / 2.0;
+    midpointPtr->y = (firstPtr->y + secondPtr->y) / 2.0;
+
+    double* radii = elementPtr->radii;
+    radii[i] = coordinate_distance(firstPtr, midpointPtr);
+}
+
+
+/* =============================================================================
+ * initEdges
+ * =============================================================================
+ */
+static void
+initEdges (element_t* elementPtr)
+{
+    long numCoordinate = elementPtr->numCoordinate;
+    long numEdge = ((numCoordinate * (numCoordinate - 1)) / 2);
+
+    elementPtr->numEdge = numEdge;
+
+    long e;
+    for (e = 0; e < numEdge; e++) {
+        setEdge(elementPtr, e);
+    }
+}
+
+
+/* =============================================================================
+ * initElement
+ * -- Everything but the neighbor list
+ * =============================================================================
+ */
+static void
+initElement (element_t* elementPtr, coordinate_t* coordinates, long numCoordinate)
+{
+    long i;
+
+    for (i = 0; i < numCoordinate; i++) {
+        elementPtr->coordinates[i] = coordinates[i];
+    }
+    elementPtr->numCoordinate = numCoordinate;
+    minimizeCoordinates(elementPtr);
+    checkAngles(elementPtr);
+    calculateCircumCircle(elementPtr);
+    initEdges(elementPtr);
+    elementPtr->isGarbage = FALSE;
+}
+
+
+/* =============================================================================
+ * compareEdge
+ * =============================================================================
+ */
+static long
+compareEdge (edge_t* aEdgePtr, edge_t* bEdgePtr)
+{
+    long diffFirst = coordinate_compare((coordinate_t*)aEdgePtr->firstPtr,
+                                        (coordinate_t*)bEdgePtr->firstPtr);
+
+    return ((diffFirst != 0) ?
+            (diffFirst) :
+            (coordinate_compare((coordinate_t*)aEdgePtr->secondPtr,
+                                (coordinate_t*)bEdgePtr->secondPtr)));
+}
+
+
+/* =============================================================================
+ * element_compare
+ * =============================================================================
+ */
+long
+element_compare (element_t* aElementPtr, element_t* bElementPtr)
+{
+    long aNumCoordinate = aElementPtr->numCoordinate;
+    long bNumCoordinate = bElementPtr->numCoordinate;
+    coordinate_t* aCoordinates = aElementPtr->coordinates;
+    coordinate_t* bCoordinates = bElementPtr->coordinates;
+
+    if (aNumCoordinate < bNumCoordinate) {
+        return -1;
+    } else if (aNumCoordinate > bNumCoordinate) {
+        return 1;
+    }
+
+    long i;
+    for (i = 0; i < aNumCoordinate; i++) {
+        long compareCoordinate =
+            coordinate_compare(&aCoordinates[i], &bCoordinates[i]);
+        if (compareCoordinate != 0) {
+            return compareCoordinate;
+        }
+    }
+
+    return 0;
+}
+
+
+/* =============================================================================
+ * element_listCompare
+ * -- For use in list_t and set
+ * =============================================================================
+ */
+long
+element_listCompare (const void* aPtr, const void* bPtr)
+{
+    element_t* aElementPtr = (element_t*)aPtr;
+    element_t* bElementPtr = (element_t*)bPtr;
+
+    return element_compare(aElementPtr, bElementPtr);
+}
+
+
+/* =============================================================================
+ * element_listCompareEdge
+ * -- Compares edges by their coordinates; for use in list_t, map and set
+ * =============================================================================
+ */
+long
+element_listCompareEdge (const void* aPtr, const void* bPtr)
+{
+    edge_t* aEdgePtr = (edge_t*)aPtr;
+    edge_t* bEdgePtr = (edge_t*)bPtr;
+
+    return compareEdge(aEdgePtr, bEdgePtr);
+}
+
+
+/* =============================================================================
+ * element_heapCompare
+ * -- For use in heap_t. Elements with encroached edges come first.
+ * =============================================================================
+ */
+long
+element_heapCompare (const void* aPtr, const void* bPtr)
+{
+    element_t* aElementPtr = (element_t*)aPtr;
+    element_t* bElementPtr = (element_t*)bPtr;
+
+    if (aElementPtr->encroachedEdgePtr) {
+        if (bElementPtr->encroachedEdgePtr) {
+            return 0; /* do not care */
+        } else {
+            return 1;
+        }
+    }
+
+    if (bElementPtr->encroachedEdgePtr) {
+        return -1;
+    }
+
+    return 0; /* do not care */
+}
+
+
+/* =============================================================================
+ * element_alloc
+ * -- Contains a copy of input arg 'coordinates'
+ * =============================================================================
+ */
+element_t*
+element_alloc (coordinate_t* coordinates, long numCoordinate)
+{
+    element_t* elementPtr;
+
+    elementPtr = (element_t*)malloc(sizeof(element_t));
+    if (elementPtr) {
+        initElement(elementPtr, coordinates, numCoordinate);
+        elementPtr->neighborListPtr = list_alloc(&element_listCompare);
+        assert(elementPtr->neighborListPtr);
+    }
+
+    return elementPtr;
+}
+
+
+/* =============================================================================
+ * TMelement_alloc
+ * -- Contains a copy of input arg 'coordinates'
+ * -- The new element is private until the transaction commits, so it is set
+ *    up with plain stores
+ * =============================================================================
+ */
+element_t*
+TMelement_alloc (TM_ARGDECL  coordinate_t* coordinates, long numCoordinate)
+{
+    element_t* elementPtr;
+
+    elementPtr = (element_t*)TM_MALLOC(sizeof(element_t));
+    if (elementPtr) {
+        initElement(elementPtr, coordinates, numCoordinate);
+        elementPtr->neighborListPtr = TMLIST_ALLOC(&element_listCompare);
+        assert(elementPtr->neighborListPtr);
+    }
+
+    return elementPtr;
+}
+
+
+/* =============================================================================
+ * element_free
+ * =============================================================================
+ */
+void
+element_free (element_t* elementPtr)
+{
+    list_free(elementPtr->neighborListPtr);
+    free(elementPtr);
+}
+
+
+/* =============================================================================
+ * TMelement_free
+ * =============================================================================
+ */
+void
+TMelement_free (TM_ARGDECL  element_t* elementPtr)
+{
+    TMLIST_FREE(elementPtr->neighborListPtr);
+    TM_FREE(elementPtr);
+}
+
+
+/* =============================================================================
+ * element_getNumEdge
+ * =============================================================================
+ */
+long
+element_getNumEdge (element_t* elementPtr)
+{
+    return elementPtr->numEdge;
+}
+
+
+/* =============================================================================
+ * element_getEdge
+ * -- Returned edgePtr is sorted; i.e., coordinate_compare(first, second) < 0
+ * =============================================================================
+ */
+edge_t*
+element_getEdge (element_t* elementPtr, long i)
+{
+    if (i < 0 || i >= elementPtr->numEdge) {
+        return NULL;
+    }
+
+    return &elementPtr->edges[i];
+}
+
+
+/* =============================================================================
+ * element_getCommonEdge
+ * -- Returns pointer to aElementPtr's shared edge, or NULL if none
+ * =============================================================================
+ */
+edge_t*
+element_getCommonEdge (element_t* aElementPtr, element_t* bElementPtr)
+{
+    edge_t* aEdges = aElementPtr->edges;
+    edge_t* bEdges = bElementPtr->edges;
+    long aNumEdge = aElementPtr->numEdge;
+    long bNumEdge = bElementPtr->numEdge;
+    long a;
+    long b;
+
+    for (a = 0; a < aNumEdge; a++) {
+        edge_t* aEdgePtr = &aEdges[a];
+        for (b = 0; b < bNumEdge; b++) {
+            edge_t* bEdgePtr = &bEdges[b];
+            if (compareEdge(aEdgePtr, bEdgePtr) == 0) {
+                return aEdgePtr;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+
+/* =============================================================================
+ * element_getNewPoint
+ * -- Either the midpoint of the encroached edge or the circumcenter
+ * =============================================================================
+ */
+coordinate_t
+element_getNewPoint (element_t* elementPtr)
+{
+    edge_t* encroachedEdgePtr = elementPtr->encroachedEdgePtr;
+
+    if (encroachedEdgePtr) {
+        long e;
+        long numEdge = elementPtr->numEdge;
+        edge_t* edges = elementPtr->edges;
+        for (e = 0; e < numEdge; e++) {
+            if (compareEdge(encroachedEdgePtr, &edges[e]) == 0) {
+                return elementPtr->midpoints[e];
+            }
+        }
+        assert(0);
+    }
+
+    return elementPtr->circumCenter;
+}
+
+
+/* =============================================================================
+ * element_checkAngles
+ * -- Return FALSE if minimum angle constraint not met
+ * =============================================================================
+ */
+bool_t
+element_checkAngles (element_t* elementPtr)
+{
+    long numCoordinate = elementPtr->numCoordinate;
+    double angleConstraint = global_angleConstraint;
+
+    if (numCoordinate == 3) {
+        long i;
+        coordinate_t* coordinates = elementPtr->coordinates;
+        for (i = 0; i < 3; i++) {
+            double angle = coordinate_angle(&coordinates[i],
+                                            &coordinates[(i + 1) % 3],
+                                            &coordinates[(i + 2) % 3]);
+            if (angle < angleConstraint) {
+                return FALSE;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+
+/* =============================================================================
+ * element_getArea
+ * =============================================================================
+ */
+double
+element_getArea (element_t* elementPtr)
+{
+    coordinate_t* coordinates = elementPtr->coordinates;
+
+    if (elementPtr->numCoordinate != 3) {
+        return 0.0;
+    }
+
+    return fabs(((coordinates[1].x - coordinates[0].x) *
+                 (coordinates[2].y - coordinates[0].y) -
+                 (coordinates[2].x - coordinates[0].x) *
+                 (coordinates[1].y - coordinates[0].y)) / 2.0);
+}
+
+
+/* =============================================================================
+ * element_isInCircumCircle
+ * =============================================================================
+ */
+bool_t
+element_isInCircumCircle (element_t* elementPtr, coordinate_t* coordinatePtr)
+{
+    double distance = coordinate_distance(coordinatePtr,
+                                          &elementPtr->circumCenter);
+
+    return ((distance <= elementPtr->circumRadius) ? TRUE : FALSE);
+}
+
+
+/* =============================================================================
+ * element_getEncroachedPtr
+ * =============================================================================
+ */
+edge_t*
+element_getEncroachedPtr (element_t* elementPtr)
+{
+    return elementPtr->encroachedEdgePtr;
+}
+
+
+/* =============================================================================
+ * element_clearEncroached
+ * -- Only while the element is private to its creator
+ * =============================================================================
+ */
+void
+element_clearEncroached (element_t* elementPtr)
+{
+    elementPtr->encroachedEdgePtr = NULL;
+}
+
+
+/* =============================================================================
+ * element_isBad
+ * -- Does it need to be refined?
+ * =============================================================================
+ */
+bool_t
+element_isBad (element_t* elementPtr)
+{
+    return ((element_getEncroachedPtr(elementPtr) != NULL) ||
+            elementPtr->isSkinny);
+}
+
+
+/* =============================================================================
+ * element_getNeighborListPtr
+ * =============================================================================
+ */
+list_t*
+element_getNeighborListPtr (element_t* elementPtr)
+{
+    return elementPtr->neighborListPtr;
+}
+
+
+/* =============================================================================
+ * element_addNeighbor
+ * =============================================================================
+ */
+void
+element_addNeighbor (element_t* elementPtr, element_t* neighborPtr)
+{
+    list_insert(elementPtr->neighborListPtr, (void*)neighborPtr);
+}
+
+
+/* =============================================================================
+ * TMelement_addNeighbor
+ * =============================================================================
+ */
+void
+TMelement_addNeighbor (TM_ARGDECL  element_t* elementPtr, element_t* neighborPtr)
+{
+    TMLIST_INSERT(elementPtr->neighborListPtr, (void*)neighborPtr);
+}
+
+
+/* =============================================================================
+ * element_setIsReferenced
+ * -- Only while the element is private to its creator
+ * =============================================================================
+ */
+void
+element_setIsReferenced (element_t* elementPtr, bool_t status)
+{
+    elementPtr->isReferenced = status;
+}
+
+
+/* =============================================================================
+ * TMelement_setIsReferenced
+ * =============================================================================
+ */
+void
+TMelement_setIsReferenced (TM_ARGDECL  element_t* elementPtr, bool_t status)
+{
+    TM_SHARED_WRITE(elementPtr->isReferenced, status);
+}
+
+
+/* =============================================================================
+ * TMelement_isReferenced
+ * -- Held by a thread or by the work heap
+ * =============================================================================
+ */
+bool_t
+TMelement_isReferenced (TM_ARGDECL  element_t* elementPtr)
+{
+    return (bool_t)TM_SHARED_READ(elementPtr->isReferenced);
+}
+
+
+/* =============================================================================
+ * TMelement_isGarbage
+ * -- Can we deallocate?
+ * =============================================================================
+ */
+bool_t
+TMelement_isGarbage (TM_ARGDECL  element_t* elementPtr)
+{
+    return (bool_t)TM_SHARED_READ(elementPtr->isGarbage);
+}
+
+
+/* =============================================================================
+ * TMelement_setIsGarbage
+ * =============================================================================
+ */
+void
+TMelement_setIsGarbage (TM_ARGDECL  element_t* elementPtr, bool_t status)
+{
+    TM_SHARED_WRITE(elementPtr->isGarbage, status);
+}
+
+
+/* =============================================================================
+ *
+ * End of element.c
+ *
+ * =============================================================================
+ */
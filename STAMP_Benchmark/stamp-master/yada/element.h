@@ -0,0 +1,355 @@
+/* =============================================================================
+ *
+ * element.h
+ *
+ * =============================================================================
+ *
+ * Copyright (C) Stanford University, 2006.  All Rights Reserved.
+ * Author: Chi Cao Minh
+ *
+ * =============================================================================
+ *
+ * For the license of bayes/sort.h and bayes/sort.c, please see the header
+ * of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of kmeans, please see kmeans/LICENSE.kmeans
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of ssca2, please see ssca2/COPYRIGHT
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/mt19937ar.c and lib/mt19937ar.h, please see the
+ * header of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/rbtree.h and lib/rbtree.c, please see
+ * lib/LEGALNOTICE.rbtree and lib/LICENSE.rbtree
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * Unless otherwise noted, the following license applies to STAMP files:
+ * 
+ * Copyright (c) 2007, Stanford University
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ * 
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ * 
+ *     * Neither the name of Stanford University nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY STANFORD UNIVERSITY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL STANFORD UNIVERSITY BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * =============================================================================
+ */
+
+
+
+#ifndef ELEMENT_H
+#define ELEMENT_H 1
+
+
+#include "coordinate.h"
+#include "list.h"
+#include "pair.h"
+#include "tm.h"
+#include "types.h"
+
+
+typedef pair_t         edge_t;
+
+/*
+ * A triangle, or a boundary segment when it has only two coordinates. Only the
+ * neighbor list and the two flags change once an element is in the mesh; the
+ * rest is set up by the allocator and may be read outside transactions.
+ */
+typedef struct element {
+    coordinate_t coordinates[3];
+    long numCoordinate;
+    coordinate_t circumCenter;
+    double circumRadius;
+    double minAngle;
+    edge_t edges[3];
+    long numEdge;
+    coordinate_t midpoints[3]; /* midpoint of each edge */
+    double radii[3];           /* half of edge length */
+    edge_t* encroachedEdgePtr; /* opposite obtuse angle */
+    bool_t isSkinny;
+    list_t* neighborListPtr;
+    bool_t isGarbage;
+    bool_t isReferenced;
+} element_t;
+
+
+/* =============================================================================
+ * element_compare
+ * =============================================================================
+ */
+long
+element_compare (element_t* aElementPtr, element_t* bElementPtr);
+
+
+/* =============================================================================
+ * element_listCompare
+ * -- For use in list_t and set
+ * =============================================================================
+ */
+long
+element_listCompare (const void* aPtr, const void* bPtr);
+
+
+/* =============================================================================
+ * element_listCompareEdge
+ * -- Compares edges by their coordinates; for use in list_t, map and set
+ * =============================================================================
+ */
+long
+element_listCompareEdge (const void* aPtr, const void* bPtr);
+
+
+/* =============================================================================
+ * element_heapCompare
+ * -- For use in heap_t. Elements with encroached edges come first.
+ * =============================================================================
+ */
+long
+element_heapCompare (const void* aPtr, const void* bPtr);
+
+
+/* =============================================================================
+ * element_alloc
+ * -- Contains a copy of input arg 'coordinates'
+ * =============================================================================
+ */
+element_t*
+element_alloc (coordinate_t* coordinates, long numCoordinate);
+
+
+/* =============================================================================
+ * TMelement_alloc
+ * -- Contains a copy of input arg 'coordinates'
+ * =============================================================================
+ */
+TM_CALLABLE
+element_t*
+TMelement_alloc (TM_ARGDECL  coordinate_t* coordinates, long numCoordinate);
+
+
+/* =============================================================================
+ * element_free
+ * =============================================================================
+ */
+void
+element_free (element_t* elementPtr);
+
+
+/* =============================================================================
+ * TMelement_free
+ * =============================================================================
+ */
+TM_CALLABLE
+void
+TMelement_free (TM_ARGDECL  element_t* elementPtr);
+
+
+/* =============================================================================
+ * element_getNumEdge
+ * =============================================================================
+ */
+long
+element_getNumEdge (element_t* elementPtr);
+
+
+/* =============================================================================
+ * element_getEdge
+ * -- Returned edgePtr is sorted; i.e., coordinate_compare(first, second) < 0
+ * =============================================================================
+ */
+edge_t*
+element_getEdge (element_t* elementPtr, long i);
+
+
+/* =============================================================================
+ * element_getCommonEdge
+ * -- Returns pointer to aElementPtr's shared edge, or NULL if none
+ * =============================================================================
+ */
+edge_t*
+element_getCommonEdge (element_t* aElementPtr, element_t* bElementPtr);
+
+
+/* =============================================================================
+ * element_getNewPoint
+ * -- Either the midpoint of the encroached edge or the circumcenter
+ * =============================================================================
+ */
+coordinate_t
+element_getNewPoint (element_t* elementPtr);
+
+
+/* =============================================================================
+ * element_checkAngles
+ * -- Return FALSE if minimum angle constraint not met
+ * =============================================================================
+ */
+bool_t
+element_checkAngles (element_t* elementPtr);
+
+
+/* =============================================================================
+ * element_getArea
+ * =============================================================================
+ */
+double
+element_getArea (element_t* elementPtr);
+
+
+/* =============================================================================
+ * element_isInCircumCircle
+ * =============================================================================
+ */
+bool_t
+element_isInCircumCircle (element_t* elementPtr, coordinate_t* coordinatePtr);
+
+
+/* =============================================================================
+ * element_getEncroachedPtr
+ * =============================================================================
+ */
+edge_t*
+element_getEncroachedPtr (element_t* elementPtr);
+
+
+/* =============================================================================
+ * element_clearEncroached
+ * -- Only while the element is private to its creator
+ * =============================================================================
+ */
+void
+element_clearEncroached (element_t* elementPtr);
+
+
+/* =============================================================================
+ * element_isBad
+ * -- Does it need to be refined?
+ * =============================================================================
+ */
+bool_t
+element_isBad (element_t* elementPtr);
+
+
+/* =============================================================================
+ * element_getNeighborListPtr
+ * =============================================================================
+ */
+list_t*
+element_getNeighborListPtr (element_t* elementPtr);
+
+
+/* =============================================================================
+ * element_addNeighbor
+ * =============================================================================
+ */
+void
+element_addNeighbor (element_t* elementPtr, element_t* neighborPtr);
+
+
+/* =============================================================================
+ * TMelement_addNeighbor
+ * =============================================================================
+ */
+TM_CALLABLE
+void
+TMelement_addNeighbor (TM_ARGDECL  element_t* elementPtr, element_t* neighborPtr);
+
+
+/* =============================================================================
+ * element_setIsReferenced
+ * -- Only while the element is private to its creator
+ * =============================================================================
+ */
+void
+element_setIsReferenced (element_t* elementPtr, bool_t status);
+
+
+/* =============================================================================
+ * TMelement_setIsReferenced
+ * =============================================================================
+ */
+TM_CALLABLE
+void
+TMelement_setIsReferenced (TM_ARGDECL  element_t* elementPtr, bool_t status);
+
+
+/* =============================================================================
+ * TMelement_isReferenced
+ * -- Held by a thread or by the work heap
+ * =============================================================================
+ */
+TM_CALLABLE
+bool_t
+TMelement_isReferenced (TM_ARGDECL  element_t* elementPtr);
+
+
+/* =============================================================================
+ * TMelement_isGarbage
+ * -- Can we deallocate?
+ * =============================================================================
+ */
+TM_CALLABLE
+bool_t
+TMelement_isGarbage (TM_ARGDECL  element_t* elementPtr);
+
+
+/* =============================================================================
+ * TMelement_setIsGarbage
+ * =============================================================================
+ */
+TM_CALLABLE
+void
+TMelement_setIsGarbage (TM_ARGDECL  element_t* elementPtr, bool_t status);
+
+
+#define TMELEMENT_ALLOC(c, n)           TMelement_alloc(TM_ARG  c, n)
+#define TMELEMENT_FREE(e)               TMelement_free(TM_ARG  e)
+#define TMELEMENT_ADDNEIGHBOR(e, n)     TMelement_addNeighbor(TM_ARG  e, n)
+#define TMELEMENT_SETISREFERENCED(e, s) TMelement_setIsReferenced(TM_ARG  e, s)
+#define TMELEMENT_ISREFERENCED(e)       TMelement_isReferenced(TM_ARG  e)
+#define TMELEMENT_ISGARBAGE(e)          TMelement_isGarbage(TM_ARG  e)
+#define TMELEMENT_SETISGARBAGE(e, s)    TMelement_setIsGarbage(TM_ARG  e, s)
+
+
+#endif /* ELEMENT_H */
+
+
+/* =============================================================================
+ *
+ * End of element.h
+ *
+ * =============================================================================
+ */
@@ -0,0 +1,184 @@
+//  generate.cpp
+//  Writes a yada input: a Delaunay triangulation of a jittered x*y grid whose rows have random heights
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+//
+//  Usage : generate <x> <y> <prefix> [seed]
+//  Writes <prefix>.node, <prefix>.poly and <prefix>.ele in the format of Triangle, e.g.
+//  generate 32 32 grid-x32-y32. The same arguments and seed (default 0) always give the same mesh.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Columns are one unit wide and rows between MIN_ROW_HEIGHT and one unit
+ * high, so the triangles of low rows are thinner than the usual angle
+ * constraints and need refining.
+ * */
+#define MIN_ROW_HEIGHT 0.15
+
+/*
+ * Inner points move by up to JITTER times the height of the lowest row next
+ * to them, which keeps the grid cells apart in the Delaunay sense.
+ * */
+#define JITTER 0.05
+
+struct point {
+	double x;
+	double y;
+};
+
+/*
+ * Positive if d lies inside the circle through a, b and c, given in
+ * counterclockwise order.
+ * */
+static double inCircle(const point &a, const point &b, const point &c, const point &d)
+{
+	double adx = a.x - d.x, ady = a.y - d.y;
+	double bdx = b.x - d.x, bdy = b.y - d.y;
+	double cdx = c.x - d.x, cdy = c.y - d.y;
+	return (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy)
+	     - (bdx * bdx + bdy * bdy) * (adx * cdy - cdx * ady)
+	     + (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+}
+
+static FILE *openOutput(const string &name)
+{
+	FILE *file = fopen(name.c_str(), "w");
+	if(file == NULL) {
+		fprintf(stderr, "Error: cannot write %s\n", name.c_str());
+		exit(1);
+	}
+	return file;
+}
+
+int main(int argc, char **argv)
+{
+	if(argc < 4 || argc > 5) {
+		fprintf(stderr, "Usage: %s <x> <y> <prefix> [seed]\n", argv[0]);
+		return 1;
+	}
+	long int width = atol(argv[1]);
+	long int height = atol(argv[2]);
+	string prefix = argv[3];
+	unsigned long long seed = (argc == 5) ? strtoull(argv[4], NULL, 10) : 0;
+	if(width < 1 || height < 1) {
+		fprintf(stderr, "Error: the dimensions must be positive\n");
+		return 1;
+	}
+
+	/*mt19937_64 gives the same sequence on every platform, unlike the
+	  distributions of <random>, so the values are scaled by hand*/
+	mt19937_64 rng(seed);
+	const double unit = 1.0 / 18446744073709551616.0;
+
+	vector<double> rowHeight(height);
+	vector<double> rowY(height + 1, 0.0);
+	for(long int j = 0;j<height;j++) {
+		rowHeight[j] = MIN_ROW_HEIGHT + (1.0 - MIN_ROW_HEIGHT) * (rng() * unit);
+		rowY[j + 1] = rowY[j] + rowHeight[j];
+	}
+
+	//points are numbered from 1, row by row; the boundary ones stay on it
+	long int rowSize = width + 1;
+	vector<point> points(rowSize * (height + 1) + 1);
+	for(long int j = 0;j<=height;j++) {
+		for(long int i = 0;i<=width;i++) {
+			point &p = points[1 + j * rowSize + i];
+			p.x = (double)i;
+			p.y = rowY[j];
+			if(i > 0 && i < width && j > 0 && j < height) {
+				double amplitude = JITTER * min(rowHeight[j - 1], rowHeight[j]);
+				p.x += amplitude * (2.0 * (rng() * unit) - 1.0);
+				p.y += amplitude * (2.0 * (rng() * unit) - 1.0);
+			}
+		}
+	}
+
+	//each cell is split along the diagonal that makes its two triangles Delaunay
+	vector<long int> triangles;
+	for(long int j = 0;j<height;j++) {
+		for(long int i = 0;i<width;i++) {
+			long int a = 1 + j * rowSize + i;
+			long int b = a + 1;
+			long int c = b + rowSize;
+			long int d = a + rowSize;
+			if(inCircle(points[a], points[b], points[c], points[d]) > 0.0) {
+				long int cell[6] = {a, b, d, b, c, d};
+				triangles.insert(triangles.end(), cell, cell + 6);
+			} else {
+				long int cell[6] = {a, b, c, a, c, d};
+				triangles.insert(triangles.end(), cell, cell + 6);
+			}
+		}
+	}
+	long int numTriangle = triangles.size() / 3;
+
+	//check that every inner edge is Delaunay, i.e. the whole mesh is
+	map<pair<long int, long int>, pair<long int, long int> > edges;
+	for(long int t = 0;t<numTriangle;t++) {
+		for(int k = 0;k<3;k++) {
+			long int u = triangles[3 * t + k];
+			long int v = triangles[3 * t + (k + 1) % 3];
+			long int w = triangles[3 * t + (k + 2) % 3];
+			pair<long int, long int> key(min(u, v), max(u, v));
+			map<pair<long int, long int>, pair<long int, long int> >::iterator it = edges.find(key);
+			if(it == edges.end()) {
+				edges[key] = make_pair(t, w);
+				continue;
+			}
+			long int s = it->second.first;
+			const long int *other = &triangles[3 * s];
+			if(inCircle(points[other[0]], points[other[1]], points[other[2]], points[w]) > 0.0) {
+				fprintf(stderr, "Error: triangles %li and %li are not Delaunay\n", s + 1, t + 1);
+				return 1;
+			}
+		}
+	}
+
+	FILE *file = openOutput(prefix + ".node");
+	fprintf(file, "%li 2 0 0\n", (long int)points.size() - 1);
+	for(size_t p = 1;p<points.size();p++) {
+		fprintf(file, "%zu %.17g %.17g\n", p, points[p].x, points[p].y);
+	}
+	fclose(file);
+
+	//the boundary segments, counterclockwise from the origin
+	vector<pair<long int, long int> > segments;
+	for(long int i = 0;i<width;i++) {
+		segments.push_back(make_pair(1 + i, 2 + i));
+	}
+	for(long int j = 0;j<height;j++) {
+		segments.push_back(make_pair(1 + j * rowSize + width, 1 + (j + 1) * rowSize + width));
+	}
+	for(long int i = width;i>0;i--) {
+		segments.push_back(make_pair(1 + height * rowSize + i, height * rowSize + i));
+	}
+	for(long int j = height;j>0;j--) {
+		segments.push_back(make_pair(1 + j * rowSize, 1 + (j - 1) * rowSize));
+	}
+	file = openOutput(prefix + ".poly");
+	fprintf(file, "0 2 0 1\n");
+	fprintf(file, "%zu 1\n", segments.size());
+	for(size_t s = 0;s<segments.size();s++) {
+		fprintf(file, "%zu %li %li 1\n", s + 1, segments[s].first, segments[s].second);
+	}
+	fprintf(file, "0\n");
+	fclose(file);
+
+	file = openOutput(prefix + ".ele");
+	fprintf(file, "%li 3 0\n", numTriangle);
+	for(long int t = 0;t<numTriangle;t++) {
+		fprintf(file, "%li %li %li %li\n", t + 1, triangles[3 * t], triangles[3 * t + 1], triangles[3 * t + 2]);
+	}
+	fclose(file);
+	return 0;
+}
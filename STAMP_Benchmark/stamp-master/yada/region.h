@@ -0,0 +1,159 @@
+/* =============================================================================
+ *
+ * region.h
+ *
+ * =============================================================================
+ *
+ * Copyright (C) Stanford University, 2006.  All Rights Reserved.
+ * Author: Chi Cao Minh
+ *
+ * =============================================================================
+ *
+ * For the license of bayes/sort.h and bayes/sort.c, please see the header
+ * of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of kmeans, please see kmeans/LICENSE.kmeans
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of ssca2, please see ssca2/COPYRIGHT
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/mt19937ar.c and lib/mt19937ar.h, please see the
+ * header of the files.
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * For the license of lib/rbtree.h and lib/rbtree.c, please see
+ * lib/LEGALNOTICE.rbtree and lib/LICENSE.rbtree
+ * 
+ * ------------------------------------------------------------------------
+ * 
+ * Unless otherwise noted, the following license applies to STAMP files:
+ * 
+ * Copyright (c) 2007, Stanford University
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ * 
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ * 
+ *     * Neither the name of Stanford University nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY STANFORD UNIVERSITY ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL STANFORD UNIVERSITY BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * =============================================================================
+ */
+
+
+
+#ifndef REGION_H
+#define REGION_H 1
+
+
+#include "element.h"
+#include "heap.h"
+#include "list.h"
+#include "map.h"
+#include "mesh.h"
+#include "queue.h"
+#include "tm.h"
+#include "vector.h"
+
+
+/*
+ * Scratch space of one thread for refining the cavity around a bad element.
+ * Nothing here is shared, so it is accessed outside the TM interface and is
+ * simply reset on the next refinement if a transaction aborts.
+ */
+typedef struct region {
+    coordinate_t centerCoordinate;
+    queue_t*     expandQueuePtr;
+    list_t*      beforeListPtr; /* before retriangulation; list to avoid duplicates */
+    list_t*      borderListPtr; /* edges adjacent to region; list to avoid duplicates */
+    MAP_T*       edgeMapPtr;    /* border and new edges -> element */
+    vector_t*    badVectorPtr;
+} region_t;
+
+
+/* =============================================================================
+ * region_alloc
+ * =============================================================================
+ */
+region_t*
+region_alloc ();
+
+
+/* =============================================================================
+ * region_free
+ * =============================================================================
+ */
+void
+region_free (region_t* regionPtr);
+
+
+/* =============================================================================
+ * TMregion_refine
+ * -- Returns net number of elements added to mesh
+ * =============================================================================
+ */
+TM_CALLABLE
+long
+TMregion_refine (TM_ARGDECL  region_t* regionPtr, element_t* elementPtr, mesh_t* meshPtr);
+
+
+/* =============================================================================
+ * region_clearBad
+ * =============================================================================
+ */
+void
+region_clearBad (region_t* regionPtr);
+
+
+/* =============================================================================
+ * TMregion_transferBad
+ * -- Moves the new bad elements to the work heap, or frees them if they were
+ *    already removed from the mesh
+ * =============================================================================
+ */
+TM_CALLABLE
+void
+TMregion_transferBad (TM_ARGDECL  region_t* regionPtr, heap_t* workHeapPtr);
+
+
+#define TMREGION_REFINE(r, e, m)        TMregion_refine(TM_ARG  r, e, m)
+#define TMREGION_TRANSFERBAD(r, h)      TMregion_transferBad(TM_ARG  r, h)
+
+
+#endif /* REGION_H */
+
+
+/* =============================================================================
+ *
+ * End of region.h
+ *
+ * =============================================================================
+ */
@@ -7,6 +7,17 @@
 #define ONE 1
 #define INFINITE 99999999;
 #define C 0.1
+#define STATS_SAMPLE 64
+#define NESTED_RETRIES 3
+#define RETRY_STRIPES 1024
+#define RETRY_TIMEOUT_MS 10
+#define FC_SLOTS 64
+#define FC_PENDING 0
+#define FC_COMMITTED 1
+#define FC_ABORTED 2
+#define NOT_LIVE LONG_MAX
+#define LIMBO_BATCH 64
+#define TRACE(type, trans, tobj) STM_TRACE_EVENT(type, (trans)->id, (trans)->g_its, (trans)->g_cts, (trans)->g_wts, (trans)->g_tltl, (trans)->g_tutl, tobj)
 /**************************** CONSTRUCTORS *****************************/
 /*
  * Global Transaction(GTransaction) class constructor
@@ -14,7 +25,6 @@
 GTransaction::GTransaction()
 {
 	g_valid = TRUEE;
-	g_lock = new mutex;
 }
 
 /*
@@ -22,16 +32,34 @@ GTransaction::GTransaction()
  * */
 Tobj::Tobj()
 {
-	tobj_lock = new mutex;
 }
 
 /*
  * Constructor of the class KSFTM which performs the initialize operation. 
  * Invoked at the start of the SWTM system. Initializes all the tobjs used by the SWTM System.
  * */
-KSFTM::KSFTM(int INITIAL_objs)
+KSFTM::KSFTM(int INITIAL_objs, int placement)
 {
+	/*With PLACE_INTERLEAVE the pages first touched while the tobjs are
+	  built are spread over all the NUMA nodes, instead of all landing on
+	  the node of the thread calling the constructor*/
+	NumaPlacement numaPlacement(placement);
+	
 	g_tCntr.store(ONE);
+	commitsInFlight.store(ZERO);
+	irrevocableActive.store(FALSEE);
+	maxCommitWts.store(ZERO);
+	retryWaiters.store(ZERO);
+	liveRecords.store(NULL);
+	
+	//zeroed commit and abort counters
+	outcomes = new OutcomeStripe[OUTCOME_STRIPES]();
+	
+	//commit sequence numbers watched by transactions waiting in stmRetry
+	commitSeq = new atomic<long int>[RETRY_STRIPES];
+	for(int i=ZERO;i<RETRY_STRIPES;i++) {
+		commitSeq[i].store(ZERO);
+	}
 	
 	// For all the tobjs used by the SWTM System
 	for(int i=ZERO;i<INITIAL_objs;i++) {
@@ -56,6 +84,22 @@ KSFTM::KSFTM(int INITIAL_objs)
 		//Push the transaction object created on the transaction objects list	
 		tobjs->push_back(*tobj); 
 	}
+	
+#ifdef CONTENTION_STATS
+	//Zero initialized contention counters, one per transaction object
+	tobjStats = new TobjStats[INITIAL_objs]();
+#endif
+
+#ifdef FLAT_COMBINING
+	//Empty commit request slots, one per live thread, all of them free
+	fcSlots = new CommitSlot[FC_SLOTS];
+	fcFree = new vector<int>();
+	for(int i=ZERO;i<FC_SLOTS;i++) {
+		fcSlots[i].request.store(NULL);
+		fcSlots[i].status.store(FC_PENDING);
+		fcFree->push_back(FC_SLOTS - ONE - i);
+	}
+#endif
 }
 
 /************************ SWTM::PRIVATE METHODS ***********************/
@@ -90,6 +134,31 @@ Version* KSFTM::findLTS_STL(long int g_wts, long int g_cts, long int tobj_id, Ve
 
 /************************ KSFTM::PRIVATE METHODS ***********************/
 
+/*
+ * Same search as findLTS_STL on a transaction object already looked up.
+ * Returns the version with the largest ts less than the transaction's and
+ * sets 'nextPos' to the version after it, which is where a version written
+ * by the transaction goes.
+ * */
+Version* KSFTM::findLTS_pos(long int g_wts, long int g_cts, Tobj *tobj, list<Version*>::iterator *nextPos)
+{
+	Version *curVer = NULL;
+	list<Version*>::iterator VL_iterator = tobj->versionList->begin();
+	
+	while(VL_iterator != tobj->versionList->end())
+	{
+		Version *ver_iterator = *VL_iterator;
+		if((ver_iterator->wts < g_wts) || ((ver_iterator->wts == g_wts) && (ver_iterator->cts < g_cts))) {
+			curVer = ver_iterator;
+		} else {
+			break;
+		}
+		VL_iterator++;
+	}
+	*nextPos = VL_iterator;
+	return curVer;
+}
+
 /*
  * Method to search for a transaction object in the 'set' passes 
  * as an argument to the function. 
@@ -102,6 +171,7 @@ bool KSFTM::find_set(vector<TobIdValPair> *set, TobIdValPair* tobj_id_val_pair)
 			if(set->at(i).id == tobj_id_val_pair->id) {
 				//set the value corresponding to the tobject in the 'tobj_id_val_pair' instance pointer.
 				tobj_id_val_pair->val = set->at(i).val;
+				tobj_id_val_pair->words = set->at(i).words;
 				//return OK
 				return TRUEE;
 			}
@@ -111,6 +181,55 @@ bool KSFTM::find_set(vector<TobIdValPair> *set, TobIdValPair* tobj_id_val_pair)
 	return FALSEE;
 }
 
+/*
+ * Entry of transaction object 'tobj_id' in 'set', which is sorted by id like
+ * the write set, or NULL if it is not there.
+ * */
+TobIdValPair* KSFTM::entryOf(vector<TobIdValPair> *set, long int tobj_id)
+{
+	vector<TobIdValPair>::iterator it = lower_bound(set->begin(), set->end(), tobj_id,
+		[](const TobIdValPair &entry, long int id) { return entry.id < id; });
+	if(it == set->end() || (*it).id != tobj_id) {
+		return NULL;
+	}
+	return &(*it);
+}
+
+/*
+ * A nested transaction also sees the values read and written by its ancestors.
+ * */
+bool KSFTM::find_nested(LTransaction* ltrans, TobIdValPair* tobj_id_val_pair)
+{
+	LTransaction *ancestor = ltrans->g_parent;
+	while(ancestor != NULL) {
+		if(find_set(ancestor->write_set, tobj_id_val_pair) == TRUEE || find_set(ancestor->read_set, tobj_id_val_pair) == TRUEE) {
+			return TRUEE;
+		}
+		ancestor = ancestor->g_parent;
+	}
+	return FALSEE;
+}
+
+/*
+ * Remove the pending increment of a transaction object from the add set.
+ * Returns TRUEE and the delta in 'tobj_id_val_pair->val' if there was one.
+ * */
+bool KSFTM::takeAdd(LTransaction* ltrans, TobIdValPair* tobj_id_val_pair)
+{
+	if(ltrans->add_set == NULL) {
+		return FALSEE;
+	}
+	vector<TobIdValPair>::iterator it;
+	for(it = ltrans->add_set->begin();it < ltrans->add_set->end();it++) {
+		if((*it).id == tobj_id_val_pair->id) {
+			tobj_id_val_pair->val = (*it).val;
+			ltrans->add_set->erase(it);
+			return TRUEE;
+		}
+	}
+	return FALSEE;
+}
+
 /*
  * Insert a transaction in the reader's list of a version of a transaction object.
  * */
@@ -151,9 +270,15 @@ void KSFTM::insertAndSortRL(list<GTransaction*> *RL, GTransaction* gtran)
 				if(gtran->g_cts < gtran_iterator->g_cts) {
 					insertFlag = TRUEE;
 					break;
-				}//if cts are same then element already exist; exclude redundancy 
+				}/*if cts are same then it is the same transaction or one of its nested
+				  transactions; order them by id and exclude redundancy*/
 				else if(gtran->g_cts == gtran_iterator->g_cts) {
-					return;
+					if(gtran == gtran_iterator) {
+						return;
+					} else if(gtran->id < gtran_iterator->id) {
+						insertFlag = TRUEE;
+						break;
+					}
 				}
 			}
 			gtran_list_iterator++;
@@ -172,86 +297,6 @@ void KSFTM::insertAndSortRL(list<GTransaction*> *RL, GTransaction* gtran)
 	}	 
 }
 
-/*
- * Insert the version and maintain the ascending order of wts value of versions of the version list
- * */
-void KSFTM::insertAndSortVL(Version *version, long int objId)
-{
-	//string str = to_string(objId)+"->"+" New Element "+to_string(version->wts)+" ";
-	
-	bool insertFlag = FALSEE;
-	list<Version*>::iterator VL_iterator;
-	Version *ver_iterator;
-	
-	if(version != NULL) {	
-		//if there is no version apart from zero'th version and K is greater than 1.
-		if(tobjs->at(objId).k==ONE && tobjs->at(objId).k != K) {
-			//tobjs->at(objId).versionList->push_back(version);
-			//increment the value of k - local to transaction object
-			//tobjs->at(objId).k++;
-			//return;
-			insertFlag = FALSEE;
-		}
-		 
-		VL_iterator = tobjs->at(objId).versionList->begin();
-		
-		//if transaction's object K versions exists than overwrite the oldest version
-		if(tobjs->at(objId).k >= K && tobjs->at(objId).versionList->size() > 0) {
-			//log the total read lists nodes to be deleted.
-			//totalReadListNodes.fetch_sub((*VL_iterator)->rl->size());
-			//erase the first version of the version list
-			VL_iterator = tobjs->at(objId).versionList->erase(VL_iterator);
-			//Subtract 1 from the total versions allocated memory log counter.
-			//totalVersions.fetch_sub(1);
-								
-			while(VL_iterator != tobjs->at(objId).versionList->end())
-			{
-				ver_iterator = *VL_iterator;
-				//insert the new version before the version which has wts value greater than current version
-				if(ver_iterator->wts > version->wts) {
-					insertFlag = TRUEE;
-					break;
-				} 
-				//if the wts values are same the use cts to get the position to insert current version
-				else if(ver_iterator->wts == version->wts && ver_iterator->cts > version->cts) {
-					insertFlag = TRUEE;
-					break;
-				}
-				VL_iterator++;
-			}
-		} 
-		/*if version list size is less than K, then insert the new version 
-			in version list without disturbing the increasing sorted order of the version list*/ 
-		else {
-			while(VL_iterator != tobjs->at(objId).versionList->end())
-			{
-				ver_iterator = *VL_iterator;
-				if(ver_iterator->wts > version->wts) {
-					insertFlag = TRUEE;
-					break;
-				} else if(ver_iterator->wts == version->wts && ver_iterator->cts > version->cts) {
-					insertFlag = TRUEE;
-					break;
-				}
-				VL_iterator++; 
-			}	
-		}
-		if(insertFlag == FALSEE) {
-				tobjs->at(objId).versionList->push_back(version);
-				//Add 1 to the total versions allocated memory log counter.
-				//totalVersions.fetch_add(1);
-				tobjs->at(objId).k++;
-			} else {
-				tobjs->at(objId).versionList->insert(VL_iterator,version);
-				//Add 1 to the total versions allocated memory log counter.
-				//totalVersions.fetch_add(1);
-				tobjs->at(objId).k++;
-		}
-	}
-}
-
-
-
 /*
  * obtain the list of reading transactions whose g_wts are
  * greater than 'g_wts' of the method invoking transaction.
@@ -339,7 +384,7 @@ void KSFTM::unlockAll(LTransaction *ltrans)
 		list<GTransaction*>::iterator itr = ltrans->trans_locked->begin();
 		while(itr != ltrans->trans_locked->end())
 			{
-				(*itr)->g_lock->unlock();
+				(*itr)->g_lock.unlock();
 				itr++;
 			}
 	}
@@ -350,7 +395,7 @@ void KSFTM::unlockAll(LTransaction *ltrans)
 		list<long int>::iterator iter = ltrans->tobjs_locked->begin();
 		while(iter != ltrans->tobjs_locked->end())
 			{
-			tobjs->at(*iter).tobj_lock->unlock();
+			tobjs->at(*iter).tobj_lock.unlock();
 			iter++;
 		}
 	}
@@ -359,14 +404,227 @@ void KSFTM::unlockAll(LTransaction *ltrans)
 	ltrans->tobjs_locked->clear();
 }
 
+/*
+ * Acquire the lock of a transaction object. With contention statistics
+ * enabled every acquisition is counted and one in STATS_SAMPLE acquisitions
+ * is timed, so that the clock is kept off the common path.
+ * */
+void KSFTM::lockTobj(long int objId)
+{
+	if(tobjStats == NULL) {
+		tobjs->at(objId).tobj_lock.lock();
+		return;
+	}
+	static thread_local long int sampleCnt = ZERO;
+	tobjStats[objId].lockAcq.fetch_add(ONE, memory_order_relaxed);
+	if((++sampleCnt % STATS_SAMPLE) != ZERO) {
+		tobjs->at(objId).tobj_lock.lock();
+		return;
+	}
+	chrono::steady_clock::time_point waitBegin = chrono::steady_clock::now();
+	tobjs->at(objId).tobj_lock.lock();
+	chrono::steady_clock::time_point waitEnd = chrono::steady_clock::now();
+	tobjStats[objId].lockWaitNs.fetch_add(chrono::duration_cast<chrono::nanoseconds>(waitEnd - waitBegin).count(), memory_order_relaxed);
+	tobjStats[objId].lockWaitSamples.fetch_add(ONE, memory_order_relaxed);
+}
+
+/*
+ * Sample the length of the reader's list of the version just read.
+ * Invoked with the transaction object lock held.
+ * */
+void KSFTM::sampleRL(long int objId, long int rlLen)
+{
+	if(tobjStats == NULL) {
+		return;
+	}
+	static thread_local long int sampleCnt = ZERO;
+	if((++sampleCnt % STATS_SAMPLE) != ZERO) {
+		return;
+	}
+	tobjStats[objId].rlLenSum.fetch_add(rlLen, memory_order_relaxed);
+	tobjStats[objId].rlSamples.fetch_add(ONE, memory_order_relaxed);
+	if(tobjStats[objId].rlLenMax.load(memory_order_relaxed) < rlLen) {
+		tobjStats[objId].rlLenMax.store(rlLen, memory_order_relaxed);
+	}
+}
+
+/*
+ * Reopen the commit gate closed by an irrevocable transaction. Invoked once
+ * the irrevocable transaction has committed, or if it is explicitly aborted.
+ * */
+void KSFTM::endIrrevocable(LTransaction *ltrans)
+{
+	if(ltrans->g_irrevocable == FALSEE) {
+		return;
+	}
+	ltrans->g_irrevocable = FALSEE;
+	irrevocableActive.store(FALSEE);
+	irrevocableLock.unlock();
+}
+
+/*
+ * Settle the memory of a finishing transaction. On commit the blocks it
+ * allocated are kept and the blocks it freed go to the limbo of its thread,
+ * as transactions that began before the commit, or that read versions older
+ * than the transaction's, may still reach them; on abort the blocks it
+ * allocated are reclaimed and its frees are dropped.
+ * */
+void KSFTM::releaseAllocs(LTransaction *ltrans, bool committed)
+{
+	if(committed == TRUEE) {
+		if(ltrans->frees != NULL && ltrans->frees->size() != ZERO) {
+			//every transaction beginning from now on has a cts, and so a wts, above the stamp
+			LimboBlock limboBlock;
+			limboBlock.stamp = max(g_tCntr.load(), ltrans->g_wts);
+			for(int i = ZERO;i<ltrans->frees->size();i++) {
+				limboBlock.ptr = ltrans->frees->at(i);
+				ltrans->g_live->limbo.push_back(limboBlock);
+			}
+			if(ltrans->g_live->limbo.size() >= LIMBO_BATCH) {
+				reclaim(ltrans->g_live);
+			}
+		}
+	} else {
+		TxBlock *block = ltrans->allocs;
+		while(block != NULL) {
+			TxBlock *next = block->next;
+			txArena()->release(block + ONE);
+			block = next;
+		}
+	}
+	ltrans->allocs = NULL;
+	if(ltrans->frees != NULL) {
+		ltrans->frees->clear();
+	}
+}
+
+/*
+ * Live record of the calling thread, taken on its first transaction: an
+ * unheld record of an exited thread if there is one, else a new one.
+ * */
+LiveRecord* KSFTM::liveRecord()
+{
+	static thread_local LiveRecordHolder holder;
+	if(holder.lib == this) {
+		return holder.record;
+	}
+	//the thread moved on to another library, give the old record back
+	if(holder.lib != NULL) {
+		holder.record->held.store(FALSEE);
+	}
+	LiveRecord *record = liveRecords.load();
+	while(record != NULL) {
+		bool unheld = FALSEE;
+		if(record->held.load() == FALSEE && record->held.compare_exchange_strong(unheld, TRUEE)) {
+			break;
+		}
+		record = record->next;
+	}
+	if(record == NULL) {
+		record = new LiveRecord;
+		record->cts.store(NOT_LIVE);
+		record->live.store(ZERO);
+		record->held.store(TRUEE);
+		record->next = liveRecords.load();
+		while(!liveRecords.compare_exchange_weak(record->next, record));
+	}
+	holder.lib = this;
+	holder.record = record;
+	return record;
+}
+
+/*
+ * Announces the top level transaction 'trans' before it takes its cts. A
+ * lower bound of the cts is published first, so a reclaimer that scans the
+ * record before the transaction is announced has read the counter before
+ * the transaction takes its cts from it. A thread already running an older
+ * transaction keeps announcing that one.
+ * */
+void KSFTM::announce(LTransaction* ltrans)
+{
+	LiveRecord *record = liveRecord();
+	if(record->live.fetch_add(ONE) == ZERO) {
+		record->cts.store(g_tCntr.load());
+	}
+	ltrans->g_live = record;
+}
+
+/*
+ * Ends the announcement of the top level transaction 'trans' once it has
+ * committed or aborted; the record stops announcing with the last live
+ * transaction of its thread.
+ * */
+void KSFTM::retire(LTransaction* ltrans)
+{
+	LiveRecord *record = ltrans->g_live;
+	if(record == NULL) {
+		return;
+	}
+	ltrans->g_live = NULL;
+	if(record->live.fetch_sub(ONE) == ONE) {
+		record->cts.store(NOT_LIVE);
+	}
+}
+
+/*
+ * Reuses the blocks in the limbo of 'record' that no live transaction can
+ * reach any more. Invoked by the thread holding the record.
+ * */
+void KSFTM::reclaim(LiveRecord* record)
+{
+	long int oldest = oldestLive();
+	int kept = ZERO;
+	for(int i = ZERO;i<record->limbo.size();i++) {
+		if(record->limbo[i].stamp < oldest) {
+			txArena()->release(record->limbo[i].ptr);
+		} else {
+			record->limbo[kept++] = record->limbo[i];
+		}
+	}
+	record->limbo.resize(kept);
+}
+
+/*
+ * Gives the live record of an exiting thread back to its library. The
+ * blocks in its limbo are reused by the next thread taking the record.
+ * */
+LiveRecordHolder::~LiveRecordHolder()
+{
+	if(record != NULL) {
+		record->live.store(ZERO);
+		record->cts.store(NOT_LIVE);
+		record->held.store(FALSEE);
+	}
+}
+
+
 /************************ KSFTM::PUBLIC METHODS ***********************/
+/*
+ * Returns a bound below the cts of every live top level transaction and of
+ * every transaction that begins later. The counter is read before the
+ * records, see announce.
+ * */
+long int KSFTM::oldestLive()
+{
+	long int oldest = g_tCntr.load();
+	LiveRecord *record = liveRecords.load();
+	while(record != NULL) {
+		oldest = min(oldest, record->cts.load());
+		record = record->next;
+	}
+	return oldest;
+}
+
 /*
  * Invoked by a thread to start a new transaction. Thread can pass a parameter 'its'
  * which is the initial timestamp when this transaction was invoked for the 
  * first time. If this is the first invocation then 'its' is NIL.
+ * If 'checkpoint' is given, stmRead, stmTryCommit, stmRetry and tbeginNested
+ * do not return ABORTED for the transaction but siglongjmp to it.
  * */
-LTransaction* KSFTM::tbegin(long int its) {
+LTransaction* KSFTM::tbegin(long int its, sigjmp_buf *checkpoint) {
 	LTransaction *trans = new LTransaction;
+	announce(trans);
 	trans->id = g_tCntr.fetch_add(ONE);
 			
 	// If this is the first invocation		
@@ -384,6 +642,77 @@ LTransaction* KSFTM::tbegin(long int its) {
 	trans->g_state = LIVE;
 	trans->g_valid = TRUEE;
 	trans->comTime = INFINITE;
+	trans->g_checkpoint = checkpoint;
+	TRACE(TRACE_BEGIN, trans, NIL);
+	
+	return trans;
+}
+
+/*
+ * Invoked by a thread to start an irrevocable transaction: one that is never
+ * invalidated and always commits, for long or I/O performing transactions.
+ * Waits until it is the sole irrevocable transaction, closes the commit gate
+ * and waits for the commits already in flight to drain. While it runs no
+ * other transaction can commit, so no version newer than what it reads can
+ * appear and nobody can invalidate it. Its its is ZERO so it wins every
+ * priority check in stmTryCommit, and its wts is above the wts of every
+ * committed version, so it always reads the latest versions.
+ * */
+LTransaction* KSFTM::tbeginIrrevocable()
+{
+	irrevocableLock.lock();
+	irrevocableActive.store(TRUEE);
+	while(commitsInFlight.load() != ZERO) {
+		this_thread::yield();
+	}
+	
+	LTransaction *trans = new LTransaction;
+	announce(trans);
+	trans->id = g_tCntr.fetch_add(ONE);
+	trans->g_its = ZERO;
+	trans->g_cts = trans->id;
+	trans->g_wts = max(trans->g_cts, maxCommitWts.load()+ONE);
+	trans->g_tltl = trans->g_cts;
+	trans->g_tutl = INFINITE;
+	trans->g_state = LIVE;
+	trans->g_valid = TRUEE;
+	trans->g_irrevocable = TRUEE;
+	trans->comTime = INFINITE;
+	TRACE(TRACE_BEGIN, trans, NIL);
+	
+	return trans;
+}
+
+/*
+ * Invoked by a thread to start a closed nested transaction inside 'parent'.
+ * The nested transaction shares the timestamps of its parent but keeps its
+ * own read and write sets, so it can abort and be retried alone while the
+ * parent's earlier reads stay valid. Returns NULL, after aborting the parent,
+ * if the parent has been invalidated or NESTED_RETRIES nested transactions
+ * in a row have aborted; the caller then retries the parent.
+ * */
+LTransaction* KSFTM::tbeginNested(LTransaction* parent)
+{
+	if(parent->g_valid == FALSEE || parent->g_nestedRetries >= NESTED_RETRIES) {
+		parent->g_nestedRetries = ZERO;
+		stmAbort(parent);
+		aborted(parent);
+		return NULL;
+	}
+	parent->g_nestedRetries++;
+	
+	LTransaction *trans = new LTransaction;
+	trans->id = g_tCntr.fetch_add(ONE);
+	trans->g_its = parent->g_its;
+	trans->g_wts = parent->g_wts;
+	trans->g_cts = parent->g_cts;
+	trans->g_tltl = parent->g_tltl;
+	trans->g_tutl = parent->g_tutl;
+	trans->g_state = LIVE;
+	trans->g_valid = TRUEE;
+	trans->g_parent = parent;
+	trans->comTime = INFINITE;
+	TRACE(TRACE_BEGIN, trans, NIL);
 	
 	return trans;
 }
@@ -397,6 +726,18 @@ LTransaction* KSFTM::tbegin(long int its) {
  * */
 bool KSFTM::stmRead(LTransaction* ltrans, TobIdValPair* tobj_id_val_pair)														
 {	
+	/*Once a transaction object with a pending increment is read, the increment
+	  becomes a write of the value read plus the delta*/
+	TobIdValPair delta;
+	delta.id = tobj_id_val_pair->id;
+	if(ltrans->add_set != NULL && takeAdd(ltrans, &delta) == TRUEE) {
+		if(stmRead(ltrans, tobj_id_val_pair) == ABORTED) {
+			return aborted(ltrans);
+		}
+		tobj_id_val_pair->val += delta.val;
+		return stmWrite(ltrans, tobj_id_val_pair);
+	}
+	
 	/*To check whether transaction object with tobj_id 
 	  is present in the writer's set of the transaction*/	
 	if(find_set(ltrans->write_set, tobj_id_val_pair) == TRUEE) {
@@ -409,20 +750,25 @@ bool KSFTM::stmRead(LTransaction* ltrans, TobIdValPair* tobj_id_val_pair)
 		return OK;
 	}
 	
+	//A nested transaction reads the values its ancestors have read or written
+	if(ltrans->g_parent != NULL && find_nested(ltrans, tobj_id_val_pair) == TRUEE) {
+		return OK;
+	}
+	
 	//Global transaction instance from local transaction
 	GTransaction *gtrans = ltrans;
 	
 	//Attain lock on transaction object
-	tobjs->at(tobj_id_val_pair->id).tobj_lock->lock();
+	lockTobj(tobj_id_val_pair->id);
 	ltrans->tobjs_locked->push_back(tobj_id_val_pair->id);
 	//Attain lock on current transaction
-	ltrans->g_lock->lock();
+	ltrans->g_lock.lock();
 	ltrans->trans_locked->push_back(gtrans);
 	
-	//Abort the transaction is transaction's valid value is FALSE
-	if(ltrans->g_valid == FALSEE) {
+	//Abort the transaction is transaction's valid value is FALSE, or its parent's is
+	if(ltrans->g_valid == FALSEE || (ltrans->g_parent != NULL && ltrans->g_parent->g_valid == FALSEE)) {
 		if(stmAbort(ltrans) == OK) {
-			return ABORTED;
+			return aborted(ltrans);
 		}
 	}
 	
@@ -432,7 +778,7 @@ bool KSFTM::stmRead(LTransaction* ltrans, TobIdValPair* tobj_id_val_pair)
 	curVer = findLTS_STL(ltrans->g_wts,ltrans->g_cts,tobj_id_val_pair->id,&nextVer);
 	if(curVer == NULL) {
 		if(stmAbort(ltrans) == OK) {
-			return ABORTED;
+			return aborted(ltrans);
 		}
 	}
 	
@@ -447,16 +793,19 @@ bool KSFTM::stmRead(LTransaction* ltrans, TobIdValPair* tobj_id_val_pair)
 	//If the limits have crossed each other, then abort the transaction
 	if(ltrans->g_tltl > ltrans->g_tutl) {
 		if(stmAbort(ltrans) == OK) {
-			return ABORTED;
+			return aborted(ltrans);
 		}
 	}
 	
 	//Add the transaction object id and value pair to the reader's list	
 	tobj_id_val_pair->val = curVer->val;
+	tobj_id_val_pair->words = curVer->words;
+	tobj_id_val_pair->mask = ZERO;
 	ltrans->read_set->push_back(*tobj_id_val_pair);
 	
 	//Add transaction to current version reader's list
 	insertAndSortRL(curVer->rl,gtrans);	
+	sampleRL(tobj_id_val_pair->id, curVer->rl->size());
 		
 	//Add transaction to max read if its the largest reading transaction.
 	//if(curVer->maxRead < gtrans->g_cts)
@@ -466,6 +815,7 @@ bool KSFTM::stmRead(LTransaction* ltrans, TobIdValPair* tobj_id_val_pair)
 	
 	//Unlock the transaction and unlock the transaction object
 	unlockAll(ltrans);
+	TRACE(TRACE_READ, ltrans, tobj_id_val_pair->id);
 	
 	//return OK
 	return OK;
@@ -483,6 +833,15 @@ bool KSFTM::stmWrite(LTransaction* ltrans, TobIdValPair* tobj_id_val_pair)
 	//Flag to check weather the new transaction <id,val> pair is inserted or not
 	bool flag = FALSEE;
 	
+	TRACE(TRACE_WRITE, ltrans, tobj_id_val_pair->id);
+	
+	//The write overwrites a pending increment of the transaction object
+	if(ltrans->add_set != NULL) {
+		TobIdValPair delta;
+		delta.id = tobj_id_val_pair->id;
+		takeAdd(ltrans, &delta);
+	}
+	
 	//if write set of the transaction is empty insert the T<id,val> pair
 	if(ltrans->write_set->size() == ZERO) {
 		ltrans->write_set->push_back(*tobj_id_val_pair);
@@ -512,74 +871,581 @@ bool KSFTM::stmWrite(LTransaction* ltrans, TobIdValPair* tobj_id_val_pair)
 }
 
 /*
- * Returns OK on commit else return ABORTED.
- * Method try to commit all the write operation stored in the, 
- * write set of the transaction.
+ * Commutative increment of transaction object 'tobj_id' by 'delta'. The delta
+ * is kept in the add set without reading the object, and applied at commit
+ * to the version preceding the transaction's and to the later versions made
+ * by increments, so concurrent increments do not conflict. An object the transaction has
+ * already read or written takes the increment as a plain write.
  * */
-bool KSFTM::stmTryCommit(LTransaction* ltrans)
+bool KSFTM::stmAdd(LTransaction* ltrans, long int tobj_id, float delta)
 {
+	TobIdValPair tobj_id_val_pair;
+	tobj_id_val_pair.id = tobj_id;
 	
-	list<long int> prevVL,nextVL;
-	list<GTransaction*> *allRL = new list<GTransaction*>;
-	list<GTransaction*> *smallRL = new list<GTransaction*>;
-	list<GTransaction*> *largeRL = new list<GTransaction*>;
-	list<GTransaction*> *abortRL = new list<GTransaction*>;
-	GTransaction *gtrans = ltrans;
-	GTransaction *gtran_iterator;
-	list<GTransaction*>::iterator gtran_list_iterator;
-	long int objId;
-	list<long int>::iterator ver_iterator;
-	
-	//Optimization check for validaity of the transaction	
-	ltrans->g_lock->lock();
-	ltrans->trans_locked->push_back(gtrans);
-	if(ltrans->g_valid == FALSEE) {
-		if(stmAbort(ltrans) == OK) {
-			return ABORTED;
-		}
+	if(find_set(ltrans->write_set, &tobj_id_val_pair) == TRUEE || find_set(ltrans->read_set, &tobj_id_val_pair) == TRUEE
+		|| (ltrans->g_parent != NULL && find_nested(ltrans, &tobj_id_val_pair) == TRUEE)) {
+		tobj_id_val_pair.val += delta;
+		return stmWrite(ltrans, &tobj_id_val_pair);
 	}
-	ltrans->trans_locked->clear();
-	ltrans->g_lock->unlock();
 	
+	TRACE(TRACE_WRITE, ltrans, tobj_id);
 	
-	//lock all transaction objects:x belongs to write_set of the transaction in pre-defined order.
-	for(int i = ZERO;i<ltrans->write_set->size();i++) {
-		objId = ltrans->write_set->at(i).id;
-		
-		tobjs->at(objId).tobj_lock->lock();
-		ltrans->tobjs_locked->push_back(objId);
-		
-		//Find the Version with largest wts value less than g_wts of the transaction
-		Version *prevVer;
-		Version *nextVer = new Version;
-		prevVer = findLTS_STL(ltrans->g_wts,ltrans->g_cts,objId,&nextVer);
-		//If no such version exists, abort the transaction and return ABORTED.
-		if(prevVer == NULL) {
-			ltrans->g_lock->lock();
-			ltrans->trans_locked->push_back(gtrans);
-			if(stmAbort(ltrans) == OK) {
-				return ABORTED;	
-			}
-		}
-		
-		// Store the previous version in prevVL
-		prevVL.push_back(prevVer->vrt);
-		
-		// Store the read-list of the previous version in allRL
-		gtran_list_iterator = prevVer->rl->begin();
-		while(gtran_list_iterator != prevVer->rl->end())
-		{
-			gtran_iterator = *gtran_list_iterator;
-			insertAndSortRL(allRL,gtran_iterator);
-			gtran_list_iterator++;
+	//accumulate the delta in the add set, kept sorted by id like the write set
+	if(ltrans->add_set == NULL) {
+		ltrans->add_set = new vector<TobIdValPair>;
+	}
+	vector<TobIdValPair>::iterator it;
+	for(it = ltrans->add_set->begin();it < ltrans->add_set->end();it++) {
+		if((*it).id == tobj_id) {
+			(*it).val += delta;
+			return OK;
+		} else if((*it).id > tobj_id) {
+			break;
 		}
-				
-		// Store the next Version in nextVL if next Version is not NULL
-		if(nextVer != NULL) {
-			nextVL.push_back(nextVer->vrt);
-		}		
 	}
-	
+	tobj_id_val_pair.val = delta;
+	ltrans->add_set->insert(it, tobj_id_val_pair);
+	return OK;
+}
+
+/*
+ * Makes each of the 'count' transaction objects from 'firstId' on hold 'words'
+ * words, e.g. the cells of a cache line or of a tile of an array, zero in the
+ * version created by transaction T0. One object then costs one lock and one
+ * version list for all its words, and transactions accessing different words
+ * of it conflict as if they accessed the same word. Must be called before any
+ * transaction begins; the objects are accessed with stmReadWord and
+ * stmWriteWord only.
+ * */
+void KSFTM::setWords(long int firstId, long int count, int words)
+{
+	if(words > OBJ_MAX_WORDS) {
+		throw length_error("KSFTM: more words per object than a write mask holds");
+	}
+	for(long int i = ZERO;i<count;i++) {
+		Tobj *tobj = &tobjs->at(firstId + i);
+		tobj->words = words;
+		if(words > ONE) {
+			tobj->versionList->front()->words = new float[words]();
+		}
+	}
+}
+
+/*
+ * Gives the transaction objects from 'firstId' on the 'n' values at 'src' in
+ * the version created by transaction T0, each object the words set with
+ * setWords, so that a large shared array is not written by an initializing
+ * transaction one word at a time. Must be called before any transaction
+ * begins.
+ * */
+void KSFTM::initWords(long int firstId, const long int *src, long int n)
+{
+	long int id = firstId;
+	for(long int i = ZERO;i<n;id++) {
+		Version *ver_T0 = tobjs->at(id).versionList->front();
+		long int words = min((long int)tobjs->at(id).words, n - i);
+		if(ver_T0->words == NULL) {
+			ver_T0->val = src[i];
+		} else {
+			for(long int w = ZERO;w<words;w++) {
+				ver_T0->words[w] = src[i + w];
+			}
+		}
+		i += words;
+	}
+}
+
+/*
+ * Reads word 'word' of transaction object 'tobj_id' into 'val'. The first
+ * access to the object reads all of it with stmRead, later ones are served
+ * from the read or write set. A single word object has only word 0.
+ * */
+bool KSFTM::stmReadWord(LTransaction* ltrans, long int tobj_id, int word, float *val)
+{
+	TobIdValPair *entry = entryOf(ltrans->write_set, tobj_id);
+	TobIdValPair tobj_id_val_pair;
+	if(entry == NULL) {
+		tobj_id_val_pair.id = tobj_id;
+		if(stmRead(ltrans, &tobj_id_val_pair) == ABORTED) {
+			return ABORTED;
+		}
+		entry = &tobj_id_val_pair;
+	}
+	*val = (entry->words != NULL) ? entry->words[word] : entry->val;
+	return OK;
+}
+
+/*
+ * Writes 'val' to word 'word' of transaction object 'tobj_id'. The first
+ * write reads the object, so that the write set holds all its words, and the
+ * word is marked in the write mask of the entry. At commit only the marked
+ * words are taken from the entry; the others come from the version the new
+ * one follows.
+ * */
+bool KSFTM::stmWriteWord(LTransaction* ltrans, long int tobj_id, int word, float val)
+{
+	int words = tobjs->at(tobj_id).words;
+	TobIdValPair tobj_id_val_pair;
+	tobj_id_val_pair.id = tobj_id;
+	if(words == ONE) {
+		tobj_id_val_pair.val = val;
+		return stmWrite(ltrans, &tobj_id_val_pair);
+	}
+	
+	TobIdValPair *entry = entryOf(ltrans->write_set, tobj_id);
+	if(entry == NULL || entry->mask == ZERO) {
+		if(stmRead(ltrans, &tobj_id_val_pair) == ABORTED) {
+			return ABORTED;
+		}
+		//from the transaction's arena, so an abort releases the copy; a commit hands it to the new version
+		float *base = tobj_id_val_pair.words;
+		tobj_id_val_pair.words = (float*)stmMalloc(ltrans, words * sizeof(float));
+		if(tobj_id_val_pair.words == NULL) {
+			throw bad_alloc();
+		}
+		if(base != NULL) {
+			memcpy(tobj_id_val_pair.words, base, words * sizeof(float));
+		} else {
+			memset(tobj_id_val_pair.words, ZERO, words * sizeof(float));
+		}
+		stmWrite(ltrans, &tobj_id_val_pair);
+		entry = entryOf(ltrans->write_set, tobj_id);
+	}
+	entry->words[word] = val;
+	entry->mask |= 1ULL << word;
+	return OK;
+}
+
+/*
+ * Returns OK on commit else return ABORTED.
+ * Commits wait at the gate while an irrevocable transaction is running;
+ * the irrevocable transaction itself owns the gate and reopens it on commit.
+ * */
+bool KSFTM::stmTryCommit(LTransaction* ltrans)
+{
+	bool status;
+	
+	//A nested transaction commits into its parent only
+	if(ltrans->g_parent != NULL) {
+		return commitNested(ltrans);
+	}
+	
+	if(ltrans->g_irrevocable == TRUEE) {
+		status = tryCommit(ltrans, NIL);
+		endIrrevocable(ltrans);
+		retire(ltrans);
+		if(status == OK) {
+			outcomeStripe()->commits.fetch_add(ONE, memory_order_relaxed);
+		}
+		return status;
+	}
+	
+	//announce the commit, backing off while an irrevocable transaction runs
+	while(TRUEE) {
+		while(irrevocableActive.load() == TRUEE) {
+			this_thread::yield();
+		}
+		commitsInFlight.fetch_add(ONE);
+		if(irrevocableActive.load() == FALSEE) {
+			break;
+		}
+		commitsInFlight.fetch_sub(ONE);
+	}
+#ifdef FLAT_COMBINING
+	//read only transactions lock no transaction object and commit on their own
+	if(ltrans->write_set->size() != ZERO || ltrans->add_set != NULL) {
+		status = combineCommit(ltrans);
+	} else {
+		status = tryCommit(ltrans, NIL);
+	}
+#else
+	status = tryCommit(ltrans, NIL);
+#endif
+	commitsInFlight.fetch_sub(ONE);
+	retire(ltrans);
+	if(status == ABORTED) {
+		return aborted(ltrans);
+	}
+	outcomeStripe()->commits.fetch_add(ONE, memory_order_relaxed);
+	return OK;
+}
+
+/*
+ * Flat combining commit: the transaction is published in the thread's slot
+ * and committed by whichever thread holds the combiner lock, possibly this
+ * one. A thread takes a slot on its first commit and holds it until it
+ * exits; while all FC_SLOTS slots are held by live threads, the others
+ * commit on their own.
+ * */
+bool KSFTM::combineCommit(LTransaction* ltrans)
+{
+	static thread_local CommitSlotHolder holder;
+	if(holder.lib != this) {
+		//the thread moved on to another library, give the old slot back
+		if(holder.lib != NULL && holder.slot != NIL) {
+			holder.lib->releaseSlot(holder.slot);
+		}
+		holder.lib = this;
+		holder.slot = NIL;
+	}
+	if(holder.slot == NIL) {
+		holder.slot = acquireSlot();
+	}
+	if(holder.slot == NIL) {
+		return tryCommit(ltrans, NIL);
+	}
+	
+	CommitSlot *mySlot = &fcSlots[holder.slot];
+	ltrans->g_combined = TRUEE;
+	mySlot->status.store(FC_PENDING);
+	mySlot->request.store(ltrans);
+	while(mySlot->status.load() == FC_PENDING) {
+		if(combinerLock.try_lock()) {
+			combine(holder.slot);
+			combinerLock.unlock();
+		} else {
+			this_thread::yield();
+		}
+	}
+	
+	/*the combiner leaves the memory and the trace of the outcome to the owner, so
+	  blocks stay in the owner's arena and events in the owner's ring*/
+	ltrans->g_combined = FALSEE;
+	if(mySlot->status.load() == FC_COMMITTED) {
+		releaseAllocs(ltrans, TRUEE);
+		TRACE(TRACE_COMMIT, ltrans, NIL);
+		return OK;
+	}
+	releaseAllocs(ltrans, FALSEE);
+	TRACE(TRACE_ABORT, ltrans, NIL);
+	return ABORTED;
+}
+
+/*
+ * Takes a free commit slot, returns NIL if every slot is held.
+ * */
+int KSFTM::acquireSlot()
+{
+	int slot = NIL;
+	fcFreeLock.lock();
+	if(fcFree->empty() == FALSEE) {
+		slot = fcFree->back();
+		fcFree->pop_back();
+	}
+	fcFreeLock.unlock();
+	return slot;
+}
+
+/*
+ * Puts the commit slot back on the free list. The slot holds no request,
+ * its owner only returns after the combiner has answered it.
+ * */
+void KSFTM::releaseSlot(int slot)
+{
+	fcFreeLock.lock();
+	fcFree->push_back(slot);
+	fcFreeLock.unlock();
+}
+
+/*
+ * Returns the slot of an exiting thread to the library it was taken from.
+ * */
+CommitSlotHolder::~CommitSlotHolder()
+{
+	if(lib != NULL && slot != NIL) {
+		lib->releaseSlot(slot);
+	}
+}
+
+/*
+ * Invoked by the combiner: collects the published requests, starting with
+ * its own slot, into a batch of transactions with disjoint write and add
+ * sets, takes one contiguous block of commit timestamps for the batch and
+ * commits the requests one after the other. Requests that overlap the batch are left
+ * for the next combiner.
+ * */
+void KSFTM::combine(int firstSlot)
+{
+	int batch[FC_SLOTS];
+	int batchSize = ZERO;
+	
+	for(int i = ZERO;i<FC_SLOTS;i++) {
+		int slot = (firstSlot + i) % FC_SLOTS;
+		LTransaction *request = fcSlots[slot].request.load();
+		if(request == NULL) {
+			continue;
+		}
+		bool disjoint = TRUEE;
+		for(int j = ZERO;j<batchSize && disjoint == TRUEE;j++) {
+			disjoint = disjointWrites(request, fcSlots[batch[j]].request.load());
+		}
+		if(disjoint == TRUEE) {
+			batch[batchSize++] = slot;
+		}
+	}
+	if(batchSize == ZERO) {
+		return;
+	}
+	
+	//one fetch_add of the global counter for the whole batch
+	long int comTime = g_tCntr.fetch_add(2*batchSize);
+	for(int j = ZERO;j<batchSize;j++) {
+		CommitSlot *slot = &fcSlots[batch[j]];
+		bool status = tryCommit(slot->request.load(), comTime + 2*j);
+		slot->request.store(NULL);
+		slot->status.store((status == OK) ? FC_COMMITTED : FC_ABORTED);
+	}
+}
+
+/*
+ * Returns TRUEE if the transactions write or increment no transaction object
+ * in common. Increments count too: the later increment of a batch would be
+ * installed on a version the earlier one has only just added.
+ * */
+bool KSFTM::disjointWrites(LTransaction* ltrans1, LTransaction* ltrans2)
+{
+	return disjointIds(ltrans1->write_set, ltrans2->write_set) == TRUEE
+		&& disjointIds(ltrans1->write_set, ltrans2->add_set) == TRUEE
+		&& disjointIds(ltrans1->add_set, ltrans2->write_set) == TRUEE
+		&& disjointIds(ltrans1->add_set, ltrans2->add_set) == TRUEE;
+}
+
+/*
+ * Returns TRUEE if the two sets, kept sorted by id and possibly NULL, have no
+ * transaction object in common.
+ * */
+bool KSFTM::disjointIds(vector<TobIdValPair> *set1, vector<TobIdValPair> *set2)
+{
+	if(set1 == NULL || set2 == NULL) {
+		return TRUEE;
+	}
+	int i = ZERO, j = ZERO;
+	while(i < set1->size() && j < set2->size()) {
+		long int id1 = set1->at(i).id;
+		long int id2 = set2->at(j).id;
+		if(id1 == id2) {
+			return FALSEE;
+		} else if(id1 < id2) {
+			i++;
+		} else {
+			j++;
+		}
+	}
+	return TRUEE;
+}
+
+/*
+ * Commit a nested transaction into its parent: its read and write sets are
+ * merged into the parent's and the parent's time limits are narrowed to its
+ * own. Nothing becomes visible to other transactions until the top level
+ * transaction commits, which validates the merged nested transactions again.
+ * */
+bool KSFTM::commitNested(LTransaction* ltrans)
+{
+	LTransaction *parent = ltrans->g_parent;
+	
+	//lock the parent and then the nested transaction, the order of the reader's lists
+	parent->g_lock.lock();
+	ltrans->trans_locked->push_back(parent);
+	ltrans->g_lock.lock();
+	ltrans->trans_locked->push_back(ltrans);
+	
+	if(ltrans->g_valid == FALSEE || parent->g_valid == FALSEE) {
+		if(stmAbort(ltrans) == OK) {
+			return ABORTED;
+		}
+	}
+	
+	//If the limits cross each other, the parent can not commit with these reads
+	long int tltl = max(parent->g_tltl, ltrans->g_tltl);
+	long int tutl = min(parent->g_tutl, ltrans->g_tutl);
+	if(tltl > tutl) {
+		if(stmAbort(ltrans) == OK) {
+			return ABORTED;
+		}
+	}
+	parent->g_tltl = tltl;
+	parent->g_tutl = tutl;
+	
+	//merge the read and the write set into the parent's
+	for(int i = ZERO;i<ltrans->read_set->size();i++) {
+		parent->read_set->push_back(ltrans->read_set->at(i));
+	}
+	for(int i = ZERO;i<ltrans->write_set->size();i++) {
+		TobIdValPair *entry = &ltrans->write_set->at(i);
+		TobIdValPair *parentEntry = (entry->mask != ZERO) ? entryOf(parent->write_set, entry->id) : NULL;
+		//words written by both keep the parent's other words
+		if(parentEntry != NULL && parentEntry->mask != ZERO) {
+			for(int w = ZERO;w<OBJ_MAX_WORDS;w++) {
+				if(entry->mask & (1ULL << w)) {
+					parentEntry->words[w] = entry->words[w];
+				}
+			}
+			parentEntry->mask |= entry->mask;
+		} else {
+			stmWrite(parent, entry);
+		}
+	}
+	if(ltrans->add_set != NULL) {
+		for(int i = ZERO;i<ltrans->add_set->size();i++) {
+			stmAdd(parent, ltrans->add_set->at(i).id, ltrans->add_set->at(i).val);
+		}
+	}
+	
+	//the parent validates this transaction, and those nested in it, on its own commit
+	if(parent->nested == NULL) {
+		parent->nested = new list<GTransaction*>;
+	}
+	parent->nested->push_back(ltrans);
+	if(ltrans->nested != NULL) {
+		parent->nested->splice(parent->nested->end(), *ltrans->nested);
+	}
+	parent->g_nestedRetries = ZERO;
+	
+	//the parent takes over the allocations and the frees
+	if(ltrans->allocs != NULL) {
+		TxBlock *block = ltrans->allocs;
+		while(block->next != NULL) {
+			block = block->next;
+		}
+		block->next = parent->allocs;
+		parent->allocs = ltrans->allocs;
+		ltrans->allocs = NULL;
+	}
+	if(ltrans->frees != NULL) {
+		for(int i = ZERO;i<ltrans->frees->size();i++) {
+			stmFree(parent, ltrans->frees->at(i));
+		}
+		ltrans->frees->clear();
+	}
+	
+	unlockAll(ltrans);
+	TRACE(TRACE_COMMIT, ltrans, NIL);
+	return OK;
+}
+
+/*
+ * Method try to commit all the write operation stored in the, 
+ * write set of the transaction. 'comTime' is the commit time handed out by
+ * the flat combiner, or NIL to take it from the global counter.
+ * */
+bool KSFTM::tryCommit(LTransaction* ltrans, long int comTime)
+{
+	
+	list<long int> prevVL,nextVL;
+	list<GTransaction*> *allRL = new list<GTransaction*>;
+	list<GTransaction*> *smallRL = new list<GTransaction*>;
+	list<GTransaction*> *largeRL = new list<GTransaction*>;
+	list<GTransaction*> *abortRL = new list<GTransaction*>;
+	GTransaction *gtrans = ltrans;
+	GTransaction *gtran_iterator;
+	list<GTransaction*>::iterator gtran_list_iterator;
+	long int objId;
+	list<long int>::iterator ver_iterator;
+	/*transaction objects written or incremented, in id order; 'adds' flags the increments,
+		whose val is the delta. Without increments this is the write set itself*/
+	vector<TobIdValPair> *cset = ltrans->write_set;
+	vector<TobIdValPair> merged;
+	vector<bool> adds;
+	if(ltrans->add_set != NULL && ltrans->add_set->size() != ZERO) {
+		int w = ZERO, a = ZERO;
+		while(w < ltrans->write_set->size() || a < ltrans->add_set->size()) {
+			if(a == ltrans->add_set->size() || (w < ltrans->write_set->size() && ltrans->write_set->at(w).id < ltrans->add_set->at(a).id)) {
+				merged.push_back(ltrans->write_set->at(w++));
+				adds.push_back(FALSEE);
+			} else {
+				merged.push_back(ltrans->add_set->at(a++));
+				adds.push_back(TRUEE);
+			}
+		}
+		cset = &merged;
+	}
+	//transaction objects, their previous versions and the positions of their new versions, kept for the install pass
+	vector<Tobj*> wTobjs;
+	vector<Version*> wPrev;
+	vector<list<Version*>::iterator> wPos;
+	wTobjs.reserve(cset->size());
+	wPrev.reserve(cset->size());
+	wPos.reserve(cset->size());
+	
+	//Optimization check for validaity of the transaction	
+	ltrans->g_lock.lock();
+	ltrans->trans_locked->push_back(gtrans);
+	if(ltrans->g_valid == FALSEE) {
+		if(stmAbort(ltrans) == OK) {
+			return ABORTED;
+		}
+	}
+	ltrans->trans_locked->clear();
+	ltrans->g_lock.unlock();
+	
+	
+	//lock all transaction objects:x belongs to write_set of the transaction in pre-defined order.
+	for(int i = ZERO;i<cset->size();i++) {
+		objId = cset->at(i).id;
+		Tobj *tobj = &(*tobjs)[objId];
+		
+		lockTobj(objId);
+		ltrans->tobjs_locked->push_back(objId);
+		
+		//Find the Version with largest wts value less than g_wts of the transaction, and the one after it
+		list<Version*>::iterator nextPos;
+		Version *prevVer = findLTS_pos(ltrans->g_wts,ltrans->g_cts,tobj,&nextPos);
+		Version *nextVer = (nextPos == tobj->versionList->end()) ? NULL : *nextPos;
+		wTobjs.push_back(tobj);
+		wPrev.push_back(prevVer);
+		wPos.push_back(nextPos);
+		//If no such version exists, abort the transaction and return ABORTED.
+		if(prevVer == NULL) {
+			ltrans->g_lock.lock();
+			ltrans->trans_locked->push_back(gtrans);
+			if(stmAbort(ltrans) == OK) {
+				return ABORTED;	
+			}
+		}
+		
+		// Store the previous version in prevVL
+		prevVL.push_back(prevVer->vrt);
+		
+		// Store the read-list of the previous version in allRL
+		gtran_list_iterator = prevVer->rl->begin();
+		while(gtran_list_iterator != prevVer->rl->end())
+		{
+			gtran_iterator = *gtran_list_iterator;
+			insertAndSortRL(allRL,gtran_iterator);
+			gtran_list_iterator++;
+		}
+				
+		/* An increment is also applied to the later versions created by increments,
+			so their readers join allRL; the first later Version written plainly bounds
+			g_tutl like the next Version of a write*/
+		if(adds.size() != ZERO && adds[i] == TRUEE) {
+			list<Version*>::iterator VL_iterator = nextPos;
+			while(VL_iterator != tobj->versionList->end() && (*VL_iterator)->add == TRUEE)
+			{
+				gtran_list_iterator = (*VL_iterator)->rl->begin();
+				while(gtran_list_iterator != (*VL_iterator)->rl->end())
+				{
+					insertAndSortRL(allRL,*gtran_list_iterator);
+					gtran_list_iterator++;
+				}
+				VL_iterator++;
+			}
+			nextVer = (VL_iterator != tobj->versionList->end()) ? *VL_iterator : NULL;
+		} else if(nextVer != NULL && nextVer->add == TRUEE) {
+			//a write below a version created by an increment would be lost, that value was taken from the versions before it
+			ltrans->g_lock.lock();
+			ltrans->trans_locked->push_back(gtrans);
+			if(stmAbort(ltrans) == OK) {
+				return ABORTED;
+			}
+		}
+		// Store the next Version in nextVL if next Version is not NULL
+		if(nextVer != NULL) {
+			nextVL.push_back(nextVer->vrt);
+		}		
+	}
+	
 	/*getLar: obtain the list of reading transactions of the previous version 
 			whose g_wts is GREATER THAN g_wts of current transaction */
 		list<GTransaction*> *preVerRL_GT;
@@ -611,13 +1477,23 @@ bool KSFTM::stmTryCommit(LTransaction* ltrans)
 	
 	//add current transaction and sort
 	insertAndSortRL(allRL,gtrans);
+	
+	//nested transactions committed into this one are locked along with it
+	if(ltrans->nested != NULL) {
+		gtran_list_iterator = ltrans->nested->begin();
+		while(gtran_list_iterator != ltrans->nested->end())
+		{
+			insertAndSortRL(allRL,*gtran_list_iterator);
+			gtran_list_iterator++;
+		}
+	}
 		
 	//lock all the transactions of the allRL list
 	gtran_list_iterator = allRL->begin();
 	while(gtran_list_iterator != allRL->end())
     {
 		gtran_iterator = *gtran_list_iterator;
-		gtran_iterator->g_lock->lock();		
+		gtran_iterator->g_lock.lock();		
 		ltrans->trans_locked->push_back(gtran_iterator);
 		gtran_list_iterator++;
 	}
@@ -629,6 +1505,23 @@ bool KSFTM::stmTryCommit(LTransaction* ltrans)
 		}
 	}
 	
+	//a nested transaction invalidated after committing into this one aborts it too
+	if(ltrans->nested != NULL) {
+		gtran_list_iterator = ltrans->nested->begin();
+		while(gtran_list_iterator != ltrans->nested->end())
+		{
+			gtran_iterator = *gtran_list_iterator;
+			if(gtran_iterator->g_valid == FALSEE) {
+				if(stmAbort(ltrans) == OK) {
+					return ABORTED;
+				}
+			}
+			ltrans->g_tltl = max(ltrans->g_tltl, gtran_iterator->g_tltl);
+			ltrans->g_tutl = min(ltrans->g_tutl, gtran_iterator->g_tutl);
+			gtran_list_iterator++;
+		}
+	}
+	
 	gtran_list_iterator = largeRL->begin();
 	//transaction Tk among all the transactions in largeRL, either current transaction or Tk has to be aborted
 	while(gtran_list_iterator != largeRL->end()) {
@@ -638,11 +1531,11 @@ bool KSFTM::stmTryCommit(LTransaction* ltrans)
 			gtran_list_iterator++;
 			continue;
 		}
-		if((ltrans->g_its < gtran_iterator->g_its) && (gtran_iterator->g_state == LIVE)) {
+		if((ltrans->g_its < gtran_iterator->g_its || ltrans->g_irrevocable == TRUEE) && (gtran_iterator->g_state == LIVE)) {
 			// if transaction has lower priority and is not yet committed. So it needs to be aborted
 			insertAndSortRL(abortRL,gtran_iterator);
-		} else {
-			// Transaction has to be aborted
+		} else if(ltrans->g_irrevocable == FALSEE) {
+			// Transaction has to be aborted; never an irrevocable one, whose wts is above every committed transaction's
 			if(stmAbort(ltrans) == OK) {
 				return ABORTED;
 			}
@@ -665,13 +1558,20 @@ bool KSFTM::stmTryCommit(LTransaction* ltrans)
 	}
 	
 	// Store the current value of the global counter as commit time and increment it
-	ltrans->comTime = g_tCntr.fetch_add(2);
+	if(comTime == NIL) {
+		ltrans->comTime = g_tCntr.fetch_add(2);
+	} else {
+		ltrans->comTime = comTime;
+	}
 	
 	// Ensure that g_tutl of the current transaction is less than or equal to comTime
 	ltrans->g_tutl = min(ltrans->g_tutl,ltrans->comTime);
 	
 	if(ltrans->g_tltl > ltrans->g_tutl) {
-		if(stmAbort(ltrans) == OK) {
+		//an irrevocable transaction is never aborted, it keeps the lower limit of the versions it follows
+		if(ltrans->g_irrevocable == TRUEE) {
+			ltrans->g_tutl = ltrans->g_tltl;
+		} else if(stmAbort(ltrans) == OK) {
 			return ABORTED;
 		}
 	}
@@ -688,7 +1588,7 @@ bool KSFTM::stmTryCommit(LTransaction* ltrans)
 		// Ensure that the limits do not cross
 		if(gtran_iterator->g_tltl >= ltrans->g_tutl)	{
 			if(gtran_iterator->g_state == LIVE) {
-				if(ltrans->g_its < gtran_iterator->g_its) {
+				if(ltrans->g_its < gtran_iterator->g_its || ltrans->g_irrevocable == TRUEE) {
 					/* Transaction Tk belong to smallRL has lower priority,
 						and is not yet committed. So it needs to be aborted*/
 					abortRL->push_back(gtran_iterator);
@@ -698,7 +1598,7 @@ bool KSFTM::stmTryCommit(LTransaction* ltrans)
 						return ABORTED;
 					}
 				}
-			} else {
+			} else if(ltrans->g_irrevocable == FALSEE) {
 				if(stmAbort(ltrans) == OK) {
 					return ABORTED;
 				}
@@ -731,28 +1631,307 @@ bool KSFTM::stmTryCommit(LTransaction* ltrans)
 		gtran_list_iterator++;
 	}
 	
-	// Having completed all the checks, current transaction can be committed	
-	for(int i = ZERO;i<ltrans->write_set->size();i++) {					
+	/* Log the largest wts of a committed transaction, read-only ones included, irrevocable
+		transactions start above it so that no committed reader follows them*/
+	long int curMax = maxCommitWts.load();
+	while(curMax < ltrans->g_wts && !maxCommitWts.compare_exchange_weak(curMax, ltrans->g_wts));
+	
+	/* Having completed all the checks, current transaction can be committed. The new
+		versions go to the positions found while locking, in a single pass over the write set */
+	//long int versionsAdded = ZERO, nodesFreed = ZERO;
+	for(int i = ZERO;i<cset->size();i++) {
+		if(i+ONE < cset->size()) {
+			__builtin_prefetch(wTobjs[i+ONE]->versionList);
+		}
+		Tobj *tobj = wTobjs[i];
+		bool isAdd = (adds.size() != ZERO && adds[i] == TRUEE);
+		
 		Version *newVer = new Version;
 		newVer->wts = ltrans->g_wts;
 		newVer->cts = ltrans->g_cts;
-		newVer->val = ltrans->write_set->at(i).val;
+		newVer->val = isAdd ? (wPrev[i]->val + cset->at(i).val) : cset->at(i).val;
+		newVer->add = isAdd;
 		newVer->vrt = ltrans->g_tltl;
+		/*a multi-word object takes the words the transaction wrote and the others from
+			the previous version, so a write never undoes a concurrent one to another word*/
+		if(tobj->words > ONE) {
+			newVer->words = wPrev[i]->words;
+			if(cset->at(i).mask != ZERO) {
+				newVer->words = cset->at(i).words;
+				for(int w = ZERO;w<tobj->words;w++) {
+					if(!(cset->at(i).mask & (1ULL << w))) {
+						newVer->words[w] = wPrev[i]->words[w];
+					}
+				}
+			}
+		}
 		
-		//method invoked to add Version to the transaction object's version list
-		insertAndSortVL(newVer, ltrans->write_set->at(i).id);
+		/*if transaction's object K versions exists than erase the oldest version; it precedes
+			the insert position, which stays valid*/
+		if(tobj->k >= K && tobj->versionList->size() > 0) {
+			//nodesFreed += tobj->versionList->front()->rl->size();
+			tobj->versionList->pop_front();
+			//versionsAdded--;
+			//Log the eviction against the transaction object
+			if(tobjStats != NULL) {
+				tobjStats[cset->at(i).id].evictions.fetch_add(ONE, memory_order_relaxed);
+			}
+		}
+		tobj->versionList->insert(wPos[i],newVer);
+		/*an increment goes into the later versions created by increments too; they are
+			replaced by new versions, as a committed version is never changed*/
+		if(isAdd) {
+			for(list<Version*>::iterator VL_iterator = wPos[i];VL_iterator != tobj->versionList->end() && (*VL_iterator)->add == TRUEE;VL_iterator++) {
+				Version *addVer = new Version(**VL_iterator);
+				addVer->val += cset->at(i).val;
+				*VL_iterator = addVer;
+			}
+		}
+		//versionsAdded++;
+		tobj->k++;
 	}
+	//Update the memory log counters once for the whole write set
+	//totalVersions.fetch_add(versionsAdded);
+	//totalReadListNodes.fetch_sub(nodesFreed);
 	
-	//change the state of the transaction to COMMIT
+	//change the state of the transaction, and of its nested transactions, to COMMIT
+	if(ltrans->nested != NULL) {
+		gtran_list_iterator = ltrans->nested->begin();
+		while(gtran_list_iterator != ltrans->nested->end())
+		{
+			(*gtran_list_iterator)->g_tltl = ltrans->g_tltl;
+			(*gtran_list_iterator)->g_state = COMMIT;
+			gtran_list_iterator++;
+		}
+	}
 	ltrans->g_state = COMMIT;
 	
+	//release the memory freed by the transaction, unless the owner does after the combiner
+	if(ltrans->g_combined == FALSEE) {
+		releaseAllocs(ltrans, TRUEE);
+	}
+	
 	//unlock all the variables
 	unlockAll(ltrans);
+	if(ltrans->g_combined == FALSEE) {
+		TRACE(TRACE_COMMIT, ltrans, NIL);
+	}
+	
+	//wake up the transactions waiting in stmRetry for the objects written
+	if(cset->size() != ZERO) {
+		for(int i = ZERO;i<cset->size();i++) {
+			commitSeq[cset->at(i).id % RETRY_STRIPES].fetch_add(ONE);
+		}
+		if(retryWaiters.load() != ZERO) {
+			lock_guard<mutex> guard(retryMutex);
+			retryCond.notify_all();
+		}
+	}
 
 	//return OK
 	return OK;
 }
 
+/*
+ * Allocate 'size' bytes inside the transaction from the thread's arena.
+ * The block is reclaimed as soon as the transaction aborts and is kept if
+ * it commits. Returns NULL if no memory is left.
+ * */
+void* KSFTM::stmMalloc(LTransaction* ltrans, size_t size)
+{
+	void *ptr = txArena()->alloc(size);
+	if(ptr != NULL) {
+		//chain the block to the transaction's allocations through its header
+		txBlock(ptr)->next = ltrans->allocs;
+		ltrans->allocs = txBlock(ptr);
+	}
+	return ptr;
+}
+
+/*
+ * Free a block allocated by stmMalloc inside the transaction. The block is
+ * released only when the transaction commits; if it aborts the block stays
+ * allocated.
+ * */
+void KSFTM::stmFree(LTransaction* ltrans, void *ptr)
+{
+	if(ptr == NULL) {
+		return;
+	}
+	if(ltrans->frees == NULL) {
+		ltrans->frees = new vector<void*>;
+	}
+	ltrans->frees->push_back(ptr);
+}
+
+/*
+ * Early release: the transaction stops being a reader of the transaction
+ * object 'tobj_id'. It is removed from the reader's lists of the object's
+ * versions and the object is dropped from its read set, so later writers no
+ * longer treat it as a conflicting reader. The time limits narrowed by the
+ * read are kept. Returns TRUEE if the object was in the read set.
+ * */
+bool KSFTM::stmRelease(LTransaction* ltrans, long int tobj_id)
+{
+	GTransaction *gtrans = ltrans;
+	vector<TobIdValPair>::iterator it;
+	
+	for(it = ltrans->read_set->begin();it < ltrans->read_set->end();it++) {
+		if((*it).id == tobj_id) {
+			break;
+		}
+	}
+	if(it == ltrans->read_set->end()) {
+		return FALSEE;
+	}
+	ltrans->read_set->erase(it);
+	
+	//remove the transaction from the reader's list of every version of the transaction object
+	lockTobj(tobj_id);
+	list<Version*>::iterator VL_iterator = tobjs->at(tobj_id).versionList->begin();
+	while(VL_iterator != tobjs->at(tobj_id).versionList->end())
+	{
+		//long int rlSize = (*VL_iterator)->rl->size();
+		(*VL_iterator)->rl->remove(gtrans);
+		//Subtract the removed nodes from the total read list nodes log counter.
+		//totalReadListNodes.fetch_sub(rlSize - (*VL_iterator)->rl->size());
+		VL_iterator++;
+	}
+	tobjs->at(tobj_id).tobj_lock.unlock();
+	
+	return TRUEE;
+}
+
+/*
+ * Copies the 'count' values held by the transaction objects from 'firstId'
+ * on, as of the wts of the transaction, to 'dst'; a multi-word object gives
+ * all its words. Unlike stmRead the transaction does not join the reader's
+ * lists and keeps its time limits, so a copy costs one version list search
+ * per object; a value the transaction acts on must be read again with
+ * stmRead or stmReadWord, which validate it. Values in the write set of the
+ * transaction replace the versions. Like stmRead, the transaction aborts if
+ * an object has no version old enough for it.
+ * */
+bool KSFTM::stmSnapshot(LTransaction* ltrans, long int firstId, long int count, long int *dst)
+{
+	list<Version*>::iterator nextPos;
+	//the write set is sorted by id, so it is walked along with the objects
+	vector<TobIdValPair>::iterator it = ltrans->write_set->begin();
+	long int id = firstId;
+	for(long int i = ZERO;i<count;id++) {
+		Tobj *tobj = &tobjs->at(id);
+		long int n = min((long int)tobj->words, count - i);
+		lockTobj(id);
+		Version *curVer = findLTS_pos(ltrans->g_wts, ltrans->g_cts, tobj, &nextPos);
+		if(curVer == NULL) {
+			ltrans->tobjs_locked->push_back(id);
+			ltrans->g_lock.lock();
+			ltrans->trans_locked->push_back(ltrans);
+			stmAbort(ltrans);
+			return aborted(ltrans);
+		}
+		for(long int w = ZERO;w<n;w++) {
+			dst[i + w] = (curVer->words != NULL) ? (long int)curVer->words[w] : (long int)curVer->val;
+		}
+		tobj->tobj_lock.unlock();
+		
+		while(it < ltrans->write_set->end() && (*it).id < id) {
+			it++;
+		}
+		if(it < ltrans->write_set->end() && (*it).id == id) {
+			for(long int w = ZERO;w<n;w++) {
+				if((*it).mask & (1ULL << w)) {
+					dst[i + w] = (long int)(*it).words[w];
+				} else if((*it).words == NULL) {
+					dst[i + w] = (long int)(*it).val;
+				}
+			}
+		}
+		i += n;
+	}
+	return OK;
+}
+
+/*
+ * Aborts transaction 'trans' and blocks the calling thread until one of the
+ * transaction objects in its read set gets a new committed version, so that
+ * a transaction whose precondition does not hold re-executes only once it
+ * may hold. Waiting is bounded by RETRY_TIMEOUT_MS. Always returns ABORTED;
+ * the caller restarts the transaction with its its as after any other abort.
+ * */
+bool KSFTM::stmRetry(LTransaction* ltrans)
+{
+	//the wait keeps vectors, which a jump to the checkpoint must not skip
+	abortAndWait(ltrans);
+	return aborted(ltrans);
+}
+
+/*
+ * Aborts 'ltrans' and, unless a version newer than it has already been
+ * committed to its read set, parks the thread until a commit advances the
+ * commit sequence of one of the objects it read.
+ * */
+void KSFTM::abortAndWait(LTransaction* ltrans)
+{
+	vector<long int> stripes;
+	vector<long int> seqs;
+	bool changed = FALSEE;
+	
+	//take the commit sequences before looking at the versions, so that no commit in between is missed
+	for(int i = ZERO;i<ltrans->read_set->size();i++) {
+		long int stripe = ltrans->read_set->at(i).id % RETRY_STRIPES;
+		stripes.push_back(stripe);
+		seqs.push_back(commitSeq[stripe].load());
+	}
+	//a version newer than the transaction may already have been committed
+	for(int i = ZERO;i<ltrans->read_set->size() && changed == FALSEE;i++) {
+		long int objId = ltrans->read_set->at(i).id;
+		lockTobj(objId);
+		if(tobjs->at(objId).versionList->back()->wts > ltrans->g_wts) {
+			changed = TRUEE;
+		}
+		tobjs->at(objId).tobj_lock.unlock();
+	}
+	
+	ltrans->g_lock.lock();
+	ltrans->trans_locked->push_back(ltrans);
+	stmAbort(ltrans);
+	
+	if(changed == TRUEE) {
+		return;
+	}
+	
+	//park until a commit advances one of the sequences taken above
+	{
+		unique_lock<mutex> guard(retryMutex);
+		retryWaiters.fetch_add(ONE);
+		retryCond.wait_for(guard, chrono::milliseconds(RETRY_TIMEOUT_MS), [&]() {
+			for(int i = ZERO;i<stripes.size();i++) {
+				if(commitSeq[stripes[i]].load() != seqs[i]) {
+					return true;
+				}
+			}
+			return false;
+		});
+		retryWaiters.fetch_sub(ONE);
+	}
+}
+
+/*
+ * Result of an operation that has aborted 'ltrans'. A transaction begun with
+ * a checkpoint never sees it: the operation jumps back to the checkpoint,
+ * after the abort has released everything the transaction held. The jump
+ * skips destructors, so no frame between the checkpoint and this call may
+ * hold a local that has one.
+ * */
+bool KSFTM::aborted(LTransaction* ltrans)
+{
+	if(ltrans->g_checkpoint != NULL) {
+		siglongjmp(*ltrans->g_checkpoint, ONE);
+	}
+	return ABORTED;
+}
+
 /*
  * Invoked by various SWTM methods to abort transaction 'trans' passed as an 
  * argument to the function. It returns A;
@@ -760,13 +1939,109 @@ bool KSFTM::stmTryCommit(LTransaction* ltrans)
 bool KSFTM::stmAbort(LTransaction* ltrans)
 {
 	if(ltrans != NULL) {
+		//count an attempt of a top level transaction once, however often it is aborted
+		if(ltrans->g_parent == NULL && ltrans->g_state != ABORT) {
+			outcomeStripe()->aborts.fetch_add(ONE, memory_order_relaxed);
+		}
+		//Attribute the abort to the transaction objects locked at this point
+		if(tobjStats != NULL) {
+			list<long int>::iterator iter = ltrans->tobjs_locked->begin();
+			while(iter != ltrans->tobjs_locked->end())
+			{
+				tobjStats[*iter].aborts.fetch_add(ONE, memory_order_relaxed);
+				iter++;
+			}
+		}
 		//set the transaction's valid value as false and state as abort
 		ltrans->g_valid = FALSEE;
 		ltrans->g_state = ABORT;
+		//nested transactions committed into this one abort with it
+		if(ltrans->nested != NULL) {
+			list<GTransaction*>::iterator itr = ltrans->nested->begin();
+			while(itr != ltrans->nested->end())
+			{
+				(*itr)->g_valid = FALSEE;
+				(*itr)->g_state = ABORT;
+				itr++;
+			}
+		}
+		//reclaim the memory allocated by the transaction, unless the owner does after the combiner
+		if(ltrans->g_combined == FALSEE) {
+			releaseAllocs(ltrans, FALSEE);
+		}
+		//the thread runs no transaction until it begins the next attempt
+		retire(ltrans);
 		//unlock all the variables
 		unlockAll(ltrans);
+		if(ltrans->g_combined == FALSEE) {
+			TRACE(TRACE_ABORT, ltrans, NIL);
+		}
+		//an aborted irrevocable transaction gives up its irrevocability
+		endIrrevocable(ltrans);
 		//Return OK status		
 		return OK;
 	}
 	return ABORTED;
 }
+
+/*
+ * Prints the 'topN' most contended transaction objects, ranked by the
+ * aborts attributed to them and then by the estimated lock wait time.
+ * Can be invoked on demand or at shutdown; prints nothing unless the
+ * library is compiled with -DCONTENTION_STATS.
+ * */
+void KSFTM::reportContention(int topN)
+{
+	if(tobjStats == NULL) {
+		return;
+	}
+	vector<long int> ids(tobjs->size());
+	for(long int i = ZERO;i<ids.size();i++) {
+		ids[i] = i;
+	}
+	//Wait time is scaled up by the sampling rate to estimate the total
+	TobjStats *stats = tobjStats;
+	sort(ids.begin(), ids.end(), [stats](long int a, long int b) {
+		if(stats[a].aborts.load() != stats[b].aborts.load()) {
+			return stats[a].aborts.load() > stats[b].aborts.load();
+		}
+		return stats[a].lockWaitNs.load() > stats[b].lockWaitNs.load();
+	});
+	cout<<"Hot transaction objects (top "<<topN<<")"<<endl;
+	cout<<"tobj\tlockAcq\twait(us)\tavgRL\tmaxRL\tevict\taborts"<<endl;
+	for(long int i = ZERO;i<topN && i<ids.size();i++) {
+		TobjStats *st = &tobjStats[ids[i]];
+		long int rlSamples = st->rlSamples.load();
+		cout<<ids[i]<<"\t"<<st->lockAcq.load()
+			<<"\t"<<(st->lockWaitNs.load()*STATS_SAMPLE)/1000
+			<<"\t"<<(rlSamples ? (double)st->rlLenSum.load()/rlSamples : 0.0)
+			<<"\t"<<st->rlLenMax.load()
+			<<"\t"<<st->evictions.load()
+			<<"\t"<<st->aborts.load()<<endl;
+	}
+}
+
+/*
+ * Counters of the calling thread, assigned round robin on its first call.
+ * */
+OutcomeStripe* KSFTM::outcomeStripe()
+{
+	static atomic<int> nextStripe(ZERO);
+	static thread_local int stripe = nextStripe.fetch_add(ONE) % OUTCOME_STRIPES;
+	return &outcomes[stripe];
+}
+
+/*
+ * Prints the commits and aborts of the top level transactions so far and
+ * the share of attempts that aborted.
+ * */
+void KSFTM::reportOutcomes()
+{
+	long int commits = ZERO, aborts = ZERO;
+	for(int i = ZERO;i<OUTCOME_STRIPES;i++) {
+		commits += outcomes[i].commits.load();
+		aborts += outcomes[i].aborts.load();
+	}
+	printf("Commits = %li, Aborts = %li, Abort rate = %.2f%%\n", commits, aborts,
+		(commits + aborts) ? 100.0 * aborts / (commits + aborts) : 0.0);
+}
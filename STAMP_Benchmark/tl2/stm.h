@@ -3,12 +3,21 @@
 #include <atomic>
 #include <cstring>
 #include <mutex>
+#include <condition_variable>
+#include <setjmp.h>
+#include "../../VLock.h"
+#include "../../Trace.h"
+#include "../../Affinity.h"
+#include "../../AddrMap.h"
+#include "../../TxAlloc.h"
 #include <algorithm>
 #include <iterator>
 #include <iostream>
 #include <stdlib.h>
 #include <map>
 #include <list>
+#include <chrono>
+#include <climits>
 
 
 
@@ -16,22 +25,13 @@
 #define ABORTED false
 #define NIL -1
 
-
-#define STM_THREAD_T 			 void
-#define STM_SELF                 tm_descriptor
-#define STM_NEW_THREAD()         0
-#define STM_INIT_THREAD(t, id)   
-#define STM_FREE_THREAD(t)
-
-
-using namespace std;
-
 /*
- * Fuctions created to sync with STAMP benchmark.
+ * Most words a multi-word transaction object holds, the bits of a write mask.
  * */
+#define OBJ_MAX_WORDS 64
+
 
-void STM_STARTUP();
-void STM_SHUTDOWN();
+using namespace std;
 
 /*
  * Enum that defines the transaction states that can be - ABORT/LIVE/COMMIT
@@ -51,6 +51,47 @@ class TobIdValPair
 	public:
 	long int id;
 	float val;
+	//words of a multi-word transaction object, NULL for a single word one
+	float *words = NULL;
+	//words written by the transaction, which owns 'words' while any bit is set
+	unsigned long long mask = 0;
+};
+
+class LTransaction;
+
+/*
+ * Block freed by a committed transaction, kept in limbo until every live
+ * transaction has begun after the commit and reads versions newer than the
+ * freeing transaction's, so no transaction can still reach the block.
+ * */
+class LimboBlock
+{
+	//public members of the class
+	public:
+	void *ptr;
+	//counter value the live transactions must have passed, see releaseAllocs
+	long int stamp;
+};
+
+/*
+ * Announcement of a thread: the cts of the oldest top level transaction it
+ * runs, or NOT_LIVE while it runs none, and the blocks freed by its committed
+ * transactions that are not reused yet. Records are never freed; the record
+ * of a thread that has exited is taken, with its limbo, by the next thread.
+ * */
+class LiveRecord
+{
+	//public members of the class
+	public:
+	atomic<long int> cts;
+	//top level transactions of the thread begun and not yet finished
+	atomic<int> live;
+	//true while a live thread holds the record
+	atomic<bool> held;
+	//freed blocks waiting until no live transaction can reach them
+	vector<LimboBlock> limbo;
+	//next record of the library
+	LiveRecord *next = NULL;
 };
 
 /*
@@ -75,14 +116,34 @@ class GTransaction
 	long int g_tutl;
 	//Flag which is initially true and is false when transaction is aborted
 	bool g_valid;
+	//Flag which is true while the transaction runs irrevocably
+	bool g_irrevocable = false;
+	//parent transaction of a nested transaction, NULL for a top level transaction
+	LTransaction *g_parent = NULL;
+	//nested transactions committed into this transaction, NULL until the first one
+	list<GTransaction*> *nested = NULL;
+	//consecutive aborts of the nested transaction currently being retried
+	int g_nestedRetries = 0;
+	//checkpoint an operation aborting the transaction jumps back to, NULL to return ABORTED
+	sigjmp_buf *g_checkpoint = NULL;
+	//pending commutative increments, sorted by id, NULL until the first one
+	vector<TobIdValPair> *add_set = NULL;
+	//blocks allocated by the transaction, chained through their headers
+	TxBlock *allocs = NULL;
+	//blocks freed by the transaction, put in limbo when it commits
+	vector<void*> *frees = NULL;
+	//record announcing the top level transaction, NULL for a nested one
+	LiveRecord *g_live = NULL;
+	//true while the flat combiner commits the transaction, whose owner then settles its memory and trace
+	bool g_combined = false;
 	//transaction objects locked by the current transaction
 	list<long int> *tobjs_locked = new list<long int>;
 	//transactions locked by the current transaction
 	list<GTransaction*> *trans_locked = new list<GTransaction*>;
 	//transation state - ABORT/LIVE/COMMIT
 	Transactionstate g_state;
-	//transaction specific lock
-	mutex* g_lock;
+	//transaction specific versioned lock word
+	VLock g_lock;
 	//Constructor
 	GTransaction();
 	//Private member of the not class.
@@ -125,8 +186,12 @@ class Version
 	long int cts;
 	//transaction object's value
 	float val;
+	//words of a multi-word transaction object, never changed once installed
+	float *words = NULL;
 	//transaction object's vrt
 	long int vrt;
+	//true if the version was created by a commutative increment
+	bool add = false;
 	//list of all transactions that have read value of the transaction object from this version
 	list<GTransaction*> *rl = new list<GTransaction*>;
 	//log max reader transaction
@@ -144,12 +209,52 @@ class Tobj
 	long int k;
 	//List of versions of the transaction object
 	list<Version*> *versionList = new list<Version*>;
-	//transcation object lock
-	mutex* tobj_lock;
+	//transcation object versioned lock word
+	VLock tobj_lock;
+	//number of words of the transaction object, set by KSFTM::setWords
+	int words = 1;
 	//constuctor
 	Tobj();
 };
 
+/*
+ * Contention counters of a transaction object. Only maintained when the
+ * library is compiled with -DCONTENTION_STATS; lock wait time and reader
+ * list length are sampled once every STATS_SAMPLE lock acquisitions.
+ * */
+class TobjStats
+{
+	//public members of the class
+	public:
+	//number of times the transaction object lock was acquired
+	atomic<long int> lockAcq;
+	//sampled lock wait time in nanoseconds and number of samples taken
+	atomic<long int> lockWaitNs;
+	atomic<long int> lockWaitSamples;
+	//sampled reader's list length of the version read
+	atomic<long int> rlLenSum;
+	atomic<long int> rlLenMax;
+	atomic<long int> rlSamples;
+	//versions erased from the version list to keep K versions
+	atomic<long int> evictions;
+	//aborts of transactions holding the transaction object lock
+	atomic<long int> aborts;
+};
+
+/*
+ * Commits and aborts of top level transactions, striped over cache lines so
+ * that threads seldom count on the same line.
+ * */
+#define OUTCOME_STRIPES 64
+class OutcomeStripe
+{
+	//public members of the class
+	public:
+	atomic<long int> commits;
+	atomic<long int> aborts;
+	char pad[64 - 2*sizeof(atomic<long int>)];
+};
+
 
 /*
  * SWTM class that provides the shared memory to all the transactions
@@ -166,6 +271,54 @@ class SWTM
 	virtual Version* findLTS_STL(long int g_wts, long int g_cts, long int tobj_id, Version**) = 0;
 };
 
+/*
+ * Commit request slot of a thread for the flat combining commit path. Only
+ * used when the library is compiled with -DFLAT_COMBINING; padded so that
+ * threads waiting on their slots do not share cache lines.
+ * */
+class CommitSlot
+{
+	//public members of the class
+	public:
+	//transaction waiting to be committed by the combiner, NULL if none
+	atomic<LTransaction*> request;
+	//outcome of the request, pending until the combiner has committed it
+	atomic<int> status;
+	char pad[64 - sizeof(atomic<LTransaction*>) - sizeof(atomic<int>)];
+};
+
+class KSFTM;
+
+/*
+ * Live record held by a thread, see LiveRecord. Kept in a thread_local, so
+ * the record is given back to the library when the thread exits.
+ * */
+class LiveRecordHolder
+{
+	//public members of the class
+	public:
+	//library the record belongs to, NULL if no record is held
+	KSFTM *lib = NULL;
+	LiveRecord *record = NULL;
+	~LiveRecordHolder();
+};
+
+/*
+ * Commit slot held by a thread for the flat combining commit path. Kept in
+ * a thread_local, so the slot goes back to the library's free list when
+ * the thread exits and a later thread can take it.
+ * */
+class CommitSlotHolder
+{
+	//public members of the class
+	public:
+	//library the slot belongs to, NULL if no slot is held
+	KSFTM *lib = NULL;
+	//index of the slot in the library's fcSlots, -1 if none is held
+	int slot = -1;
+	~CommitSlotHolder();
+};
+
 /*
  * class KSFTM - K starvation freedom transaction management
  * inherits the SWTM class
@@ -175,25 +328,95 @@ class SWTM
 class KSFTM : public virtual SWTM	
 {
 	public:
-	//Constructor
-	KSFTM(int INITIAL_objs);	
+	//Constructor, the tobjs are allocated as the PlacementPolicy 'placement' says
+	KSFTM(int INITIAL_objs, int placement = PLACE_FIRST_TOUCH);	
 	
 	//Private member functions
 	private:
 		bool find_set(vector<TobIdValPair> *set, TobIdValPair* tobj_id_val_pair);
+		TobIdValPair* entryOf(vector<TobIdValPair> *set, long int tobj_id);
 		void insertAndSortRL(list<GTransaction*> *RL, GTransaction *gtrans);
-		void insertAndSortVL(Version *version, long int objId);
 		list<GTransaction*>* getLar(long int g_wts, long int g_cts, list<GTransaction*> *preVerRL);
 		list<GTransaction*>* getSm(long int g_wts, long int g_cts, list<GTransaction*> *preVerRL);
 		bool isAborted(GTransaction* gtrans);
 		void unlockAll(LTransaction *ltrans);
 		Version* findLTS_STL(long int g_wts, long int g_cts, long int tobj_id, Version**);
-				
-	//Public member functions	
-	public:	
-		LTransaction* tbegin(long int its);
+		Version* findLTS_pos(long int g_wts, long int g_cts, Tobj *tobj, list<Version*>::iterator *nextPos);
+		void lockTobj(long int objId);
+		void sampleRL(long int objId, long int rlLen);
+		bool tryCommit(LTransaction* trans, long int comTime);
+		void endIrrevocable(LTransaction* trans);
+		bool find_nested(LTransaction* trans, TobIdValPair* tobj_id_val_pair);
+		bool takeAdd(LTransaction* trans, TobIdValPair* tobj_id_val_pair);
+		bool commitNested(LTransaction* trans);
+		void releaseAllocs(LTransaction* trans, bool committed);
+		OutcomeStripe* outcomeStripe();
+		bool aborted(LTransaction* trans);
+		void abortAndWait(LTransaction* trans);
+		LiveRecord* liveRecord();
+		void announce(LTransaction* trans);
+		void retire(LTransaction* trans);
+		void reclaim(LiveRecord* record);
+		bool combineCommit(LTransaction* trans);
+		int acquireSlot();
+		void releaseSlot(int slot);
+		void combine(int firstSlot);
+		bool disjointWrites(LTransaction* trans1, LTransaction* trans2);
+		bool disjointIds(vector<TobIdValPair> *set1, vector<TobIdValPair> *set2);
+
+	//Private member variables
+	private:
+		//per transaction object contention counters, NULL when not compiled in
+		TobjStats *tobjStats = NULL;
+		//commit and abort counters
+		OutcomeStripe *outcomes = NULL;
+		//commits that passed the irrevocability gate and have not finished yet
+		atomic<long int> commitsInFlight;
+		//true while an irrevocable transaction is running
+		atomic<bool> irrevocableActive;
+		//held by the sole irrevocable transaction from tbegin to commit
+		VLock irrevocableLock;
+		//commit sequence numbers of the transaction objects, striped by id
+		atomic<long int> *commitSeq = NULL;
+		//transactions parked in stmRetry and the condition they wait on
+		atomic<long int> retryWaiters;
+		mutex retryMutex;
+		condition_variable retryCond;
+		//largest wts of a committed transaction, read-only ones included
+		atomic<long int> maxCommitWts;
+		//per thread commit request slots, NULL when flat combining is not compiled in
+		CommitSlot *fcSlots = NULL;
+		//held by the thread committing a batch of requests
+		VLock combinerLock;
+		//indices of the commit slots not held by any live thread
+		vector<int> *fcFree = NULL;
+		//guards fcFree
+		VLock fcFreeLock;
+		//live records of the threads that have run transactions, pushed at the head
+		atomic<LiveRecord*> liveRecords;
+	friend class CommitSlotHolder;
+	friend class LiveRecordHolder;
+
+	//Public member functions
+	public:
+		LTransaction* tbegin(long int its, sigjmp_buf *checkpoint = NULL);
+		LTransaction* tbeginIrrevocable();
+		LTransaction* tbeginNested(LTransaction* parent);
 		bool stmRead(LTransaction* trans, TobIdValPair *tobj_id_val_pair);
 		bool stmWrite(LTransaction* trans, TobIdValPair *tobj_id_val_pair);
+		bool stmAdd(LTransaction* trans, long int tobj_id, float delta);
+		void setWords(long int firstId, long int count, int words);
+		void initWords(long int firstId, const long int *src, long int n);
+		bool stmReadWord(LTransaction* trans, long int tobj_id, int word, float *val);
+		bool stmWriteWord(LTransaction* trans, long int tobj_id, int word, float val);
 		bool stmTryCommit(LTransaction* trans);
 		bool stmAbort(LTransaction* trans);
+		bool stmRetry(LTransaction* trans);
+		bool stmRelease(LTransaction* trans, long int tobj_id);
+		bool stmSnapshot(LTransaction* trans, long int firstId, long int count, long int *dst);
+		void* stmMalloc(LTransaction* trans, size_t size);
+		void stmFree(LTransaction* trans, void *ptr);
+		void reportContention(int topN);
+		void reportOutcomes();
+		long int oldestLive();
 };
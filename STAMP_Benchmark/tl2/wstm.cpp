@@ -0,0 +1,203 @@
+//  wstm.cpp
+//  Word based STM interface of STAMP (STM_READ/STM_WRITE) on top of KSFTM
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+
+#include "wstm.h"
+
+KSFTM *wordLib = NULL;
+atomic<long int> *wordStamps = NULL;
+
+/*
+ * Creates the orecs. Every orec starts with stamp 0, the wts of the
+ * version created by transaction T0.
+ * */
+void wordStartup(long numThread)
+{
+	wordLib = new KSFTM(WORD_ORECS);
+	wordStamps = new atomic<long int>[WORD_ORECS];
+	for(long int i=0;i<WORD_ORECS;i++) {
+		wordStamps[i].store(0);
+	}
+}
+
+/*
+ * Prints how many word transactions committed and aborted.
+ * */
+void wordShutdown()
+{
+	wordLib->reportOutcomes();
+}
+
+WordTx::WordTx()
+{
+	threadId = 0;
+	T = NULL;
+	retrying = false;
+}
+
+/*
+ * Frees the blocks left in limbo that no live transaction can reach; the
+ * others are never freed, as a live transaction may still read them.
+ * */
+WordTx::~WordTx()
+{
+	if(limbo.size() != 0) {
+		reclaim();
+	}
+}
+
+/*
+ * Begins an attempt of the transaction. A retried attempt keeps the its of
+ * the first one.
+ * */
+void WordTx::begin()
+{
+	orecs.clear();
+	written.clear();
+	redo.clear();
+	logged.clear();
+	T = wordLib->tbegin(retrying ? T->g_its : NIL);
+}
+
+/*
+ * Returns the stamp the orec had when the transaction first accessed it. The
+ * first access reads the tobj of the orec, so that KSFTM orders the
+ * transaction after the version in memory.
+ * */
+long int WordTx::touch(long int orec)
+{
+	unordered_map<long int, long int>::iterator it = orecs.find(orec);
+	if(it != orecs.end()) {
+		return it->second;
+	}
+	long int stamp = wordStamps[orec].load(memory_order_acquire);
+	for(int spins = 0;stamp == WORD_LOCKED;spins++) {
+		if(spins == WORD_SPINS) {
+			restart();
+		}
+		stamp = wordStamps[orec].load(memory_order_acquire);
+	}
+	//Words written after the transaction's wts are not in its snapshot
+	if(stamp > T->g_wts) {
+		restart();
+	}
+	TobIdValPair tobj_id_val_pair;
+	tobj_id_val_pair.id = orec;
+	if(wordLib->stmRead(T, &tobj_id_val_pair) == ABORTED) {
+		restart(true);
+	}
+	if(wordStamps[orec].load(memory_order_acquire) != stamp) {
+		restart();
+	}
+	orecs[orec] = stamp;
+	return stamp;
+}
+
+/*
+ * Commits the transaction. The stamps of the written orecs are locked, only
+ * if they are unchanged since the transaction first accessed them, before
+ * KSFTM validates the commit; the words are written back and the stamps set
+ * to the wts of the transaction after it.
+ * */
+void WordTx::commit()
+{
+	size_t locked = 0;
+	for(;locked<written.size();locked++) {
+		long int stamp = orecs[written[locked]];
+		if(!wordStamps[written[locked]].compare_exchange_strong(stamp, WORD_LOCKED)) {
+			break;
+		}
+	}
+	if(locked < written.size()) {
+		for(size_t i=0;i<locked;i++) {
+			wordStamps[written[i]].store(orecs[written[i]], memory_order_release);
+		}
+		restart();
+	}
+
+	if(wordLib->stmTryCommit(T) == ABORTED) {
+		for(size_t i=0;i<written.size();i++) {
+			wordStamps[written[i]].store(orecs[written[i]], memory_order_release);
+		}
+		restart(true);
+	}
+
+	for(size_t i=0;i<redo.size();i++) {
+		memcpy(redo[i].addr, &redo[i].bits, redo[i].size);
+	}
+	for(size_t i=0;i<written.size();i++) {
+		wordStamps[written[i]].store(T->g_wts, memory_order_release);
+	}
+	//A transaction beginning from now on reads the words written back, so
+	//only the live ones may still reach the freed blocks
+	if(frees.size() != 0) {
+		LimboBlock limboBlock;
+		limboBlock.stamp = max(wordLib->g_tCntr.load(), T->g_wts);
+		for(size_t i=0;i<frees.size();i++) {
+			limboBlock.ptr = frees[i];
+			limbo.push_back(limboBlock);
+		}
+		if(limbo.size() >= WORD_LIMBO_BATCH) {
+			reclaim();
+		}
+	}
+	allocs.clear();
+	frees.clear();
+	retrying = false;
+}
+
+/*
+ * Aborts the current attempt, unless KSFTM already has, and jumps back to
+ * STM_BEGIN to retry it.
+ * */
+void WordTx::restart(bool engineAborted)
+{
+	if(!engineAborted) {
+		wordLib->stmAbort(T);
+	}
+	for(size_t i=0;i<allocs.size();i++) {
+		::free(allocs[i]);
+	}
+	allocs.clear();
+	frees.clear();
+	retrying = true;
+	siglongjmp(env, 1);
+}
+
+/*
+ * Frees the blocks in limbo whose freeing transaction committed before
+ * every live transaction began.
+ * */
+void WordTx::reclaim()
+{
+	long int oldest = wordLib->oldestLive();
+	size_t kept = 0;
+	for(size_t i=0;i<limbo.size();i++) {
+		if(limbo[i].stamp < oldest) {
+			::free(limbo[i].ptr);
+		} else {
+			limbo[kept++] = limbo[i];
+		}
+	}
+	limbo.resize(kept);
+}
+
+/*
+ * Allocates a block that is freed again if the attempt aborts.
+ * */
+void* WordTx::malloc(size_t size)
+{
+	void *ptr = ::malloc(size);
+	allocs.push_back(ptr);
+	return ptr;
+}
+
+/*
+ * Frees the block 'ptr' once the transaction has committed and no live
+ * transaction can reach it any more.
+ * */
+void WordTx::free(void *ptr)
+{
+	frees.push_back(ptr);
+}
@@ -0,0 +1,217 @@
+//  wstm.h
+//  Word based STM interface of STAMP (STM_READ/STM_WRITE) on top of KSFTM
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+
+#ifndef WSTM_H
+#define WSTM_H
+
+#include <setjmp.h>
+#include <stdint.h>
+#include <unordered_map>
+#include "stm.h"
+
+/*
+ * Ownership records: every shared word is hashed onto one of WORD_ORECS
+ * KSFTM transaction objects, a power of two. Words sharing an orec conflict
+ * with each other.
+ * */
+#ifndef WORD_ORECS
+#define WORD_ORECS (1 << 16)
+#endif
+
+/*
+ * Stamp of an orec while a commit writes its words back to memory.
+ * */
+#define WORD_LOCKED -2
+
+/*
+ * Times a transaction polls a locked orec before it aborts.
+ * */
+#define WORD_SPINS 1024
+
+/*
+ * Blocks a thread keeps in limbo before it tries to free the oldest.
+ * */
+#define WORD_LIMBO_BATCH 64
+
+/*
+ * KSFTM instance whose tobjs are the orecs, created by STM_STARTUP.
+ * */
+extern KSFTM *wordLib;
+
+/*
+ * Stamp of every orec: the wts of the last transaction that wrote words of
+ * the orec back to memory, or WORD_LOCKED while one is doing so.
+ * */
+extern atomic<long int> *wordStamps;
+
+void wordStartup(long numThread);
+void wordShutdown();
+
+/*
+ * Orec of the word holding 'addr'.
+ * */
+inline long int wordOrec(const void *addr)
+{
+	return (long int)((((uintptr_t)addr >> 3) * 0x9e3779b97f4a7c15ULL) >> 32) & (WORD_ORECS - 1);
+}
+
+/*
+ * A word written by a transaction, kept until it commits.
+ * */
+class WordEntry
+{
+	//public members of the class
+	public:
+	void *addr;
+	uint64_t bits;
+	int size;
+};
+
+/*
+ * Word based transaction of a thread, reused by all its transactions.
+ *
+ * Shared words stay in memory and a transaction buffers its writes in a redo
+ * log. KSFTM detects the conflicts: the first access to an orec reads its
+ * tobj, so the transaction joins the reader list of the current version,
+ * and the first write to it writes the tobj. Words are written back only
+ * while the commit holds the stamps of the written orecs, so memory always
+ * holds the latest version of each orec. A read is consistent if the stamp
+ * of the orec is unchanged from the first access to after the word is
+ * loaded, and if that stamp is below the wts of the transaction, i.e. the
+ * words in memory are the version KSFTM lets the transaction read.
+ *
+ * Aborts jump back to the sigsetjmp of STM_BEGIN, which begins the
+ * transaction again with the its of the aborted one, as KSFTM requires for
+ * starvation freedom. Every word accessed by one transaction must be
+ * accessed with the same size, of at most 8 bytes.
+ *
+ * Blocks come from malloc, so STM_FREE also takes blocks allocated outside
+ * transactions. A block freed by a committed transaction stays in the
+ * thread's limbo until every live transaction began after the commit, as an
+ * older one may still read the block through a pointer it loaded before.
+ * */
+class WordTx
+{
+	//public members of the class
+	public:
+	sigjmp_buf env;
+	//STAMP thread id of the owning thread
+	long int threadId;
+	//KSFTM transaction of the current attempt
+	LTransaction *T;
+
+	WordTx();
+	~WordTx();
+	void begin();
+	void commit();
+	void restart(bool engineAborted = false);
+	void* malloc(size_t size);
+	void free(void *ptr);
+
+	template<class V> V read(V *addr);
+	template<class V, class W> void write(V *addr, W val);
+
+	//private members of the class
+	private:
+	//true once an attempt has aborted, until the transaction commits
+	bool retrying;
+	//orecs accessed by the transaction and their stamps at the first access
+	unordered_map<long int, long int> orecs;
+	//orecs written by the transaction
+	vector<long int> written;
+	//redo log and the position of every logged address in it
+	vector<WordEntry> redo;
+	unordered_map<void*, size_t> logged;
+	//blocks allocated and freed by the current attempt
+	vector<void*> allocs;
+	vector<void*> frees;
+	//blocks freed by committed transactions, not freed to malloc yet
+	vector<LimboBlock> limbo;
+
+	long int touch(long int orec);
+	void reclaim();
+};
+
+/*
+ * Reads the word at 'addr'. Aborts the transaction, so never returns, if
+ * the word is not part of a consistent snapshot.
+ * */
+template<class V> V WordTx::read(V *addr)
+{
+	static_assert(sizeof(V) <= sizeof(uint64_t), "STM_READ of a variable larger than a word");
+	V val;
+	unordered_map<void*, size_t>::iterator it = logged.find(addr);
+	if(it != logged.end()) {
+		memcpy(&val, &redo[it->second].bits, sizeof(V));
+		return val;
+	}
+	long int orec = wordOrec(addr);
+	long int stamp = touch(orec);
+	val = *(volatile V*)addr;
+	atomic_thread_fence(memory_order_acquire);
+	if(wordStamps[orec].load(memory_order_relaxed) != stamp) {
+		restart();
+	}
+	return val;
+}
+
+/*
+ * Writes 'val' to the word at 'addr' in the redo log.
+ * */
+template<class V, class W> void WordTx::write(V *addr, W val)
+{
+	static_assert(sizeof(V) <= sizeof(uint64_t), "STM_WRITE of a variable larger than a word");
+	V word = (V)val;
+	unordered_map<void*, size_t>::iterator it = logged.find(addr);
+	if(it != logged.end()) {
+		memcpy(&redo[it->second].bits, &word, sizeof(V));
+		return;
+	}
+	long int orec = wordOrec(addr);
+	touch(orec);
+	if(find(written.begin(), written.end(), orec) == written.end()) {
+		TobIdValPair tobj_id_val_pair;
+		tobj_id_val_pair.id = orec;
+		tobj_id_val_pair.val = 0;
+		wordLib->stmWrite(T, &tobj_id_val_pair);
+		written.push_back(orec);
+	}
+	WordEntry entry;
+	entry.addr = addr;
+	entry.bits = 0;
+	memcpy(&entry.bits, &word, sizeof(V));
+	entry.size = sizeof(V);
+	logged[addr] = redo.size();
+	redo.push_back(entry);
+}
+
+#define STM_THREAD_T             WordTx
+#define STM_SELF                 tm_descriptor
+#define STM_NEW_THREAD()         new WordTx()
+#define STM_INIT_THREAD(t, id)   (t)->threadId = (id)
+#define STM_FREE_THREAD(t)       delete (t)
+
+#define STM_STARTUP(numThread)   wordStartup(numThread)
+#define STM_SHUTDOWN()           wordShutdown()
+
+#define STM_BEGIN_WR()           do { sigsetjmp(STM_SELF->env, 0); STM_SELF->begin(); } while(0)
+#define STM_BEGIN_RD()           STM_BEGIN_WR()
+#define STM_END()                STM_SELF->commit()
+#define STM_RESTART()            STM_SELF->restart()
+
+#define STM_READ(var)            STM_SELF->read(&(var))
+#define STM_READ_P(var)          STM_SELF->read(&(var))
+#define STM_READ_F(var)          STM_SELF->read(&(var))
+#define STM_WRITE(var, val)      STM_SELF->write(&(var), val)
+#define STM_WRITE_P(var, val)    STM_SELF->write(&(var), val)
+#define STM_WRITE_F(var, val)    STM_SELF->write(&(var), val)
+#define STM_LOCAL_WRITE(var, val)   ((var) = (val))
+#define STM_LOCAL_WRITE_P(var, val) ((var) = (val))
+#define STM_LOCAL_WRITE_F(var, val) ((var) = (val))
+
+#define STM_MALLOC(size)         STM_SELF->malloc(size)
+#define STM_FREE(ptr)            STM_SELF->free(ptr)
+
+#endif /* WSTM_H */
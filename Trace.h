@@ -0,0 +1,267 @@
+//  Trace.h
+//  Per thread event tracing shared by KSFTM, PKTO and SFTM
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+
+#ifndef TRACE_H
+#define TRACE_H
+
+/*
+ * Kinds of events recorded for a transaction.
+ * */
+enum TraceType{TRACE_BEGIN,TRACE_READ,TRACE_WRITE,TRACE_COMMIT,TRACE_ABORT};
+
+/*
+ * Binary trace event of 64 bytes, one cache line. Timestamps and limits are
+ * kept in 64 bits like the counters they come from; fields an STM does not
+ * have are NIL.
+ * */
+class TraceEvent
+{
+	//public members of the class
+	public:
+	//clock ticks at the time of the event
+	long int ts;
+	//transaction timestamps and limits at the time of the event
+	long int its;
+	long int cts;
+	long int wts;
+	long int tltl;
+	long int tutl;
+	//transaction object read or written, NIL for the other events
+	long int tobj;
+	//transaction id
+	int id;
+	//index of the recording thread
+	short tid;
+	//TraceType of the event
+	short type;
+};
+
+/*
+ * Header of a trace file: the magic, the number of events that follow and
+ * the length of a clock tick.
+ * */
+class TraceHeader
+{
+	//public members of the class
+	public:
+	char magic[8];
+	long int count;
+	double nsPerTick;
+};
+
+#define TRACE_MAGIC "STMTRACE"
+
+/*
+ * Tracing is a debug build option: every event costs a 64 byte store on the
+ * recording thread, and begin, commit and abort events a clock read too. By
+ * default only those are recorded, a few percent on short transactions;
+ * -DSTM_TRACE_ACCESSES also records every read and write. Reads and writes
+ * reuse the time of the thread's last event and read the clock only every
+ * TRACE_CLOCK_EVERY accesses, as the clock read is most of the cost of an
+ * event, so they are stamped up to that many accesses early.
+ * */
+#ifdef STM_TRACE
+
+#include <atomic>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+/*
+ * Events kept per thread, a power of two; older events are overwritten.
+ * */
+#ifndef TRACE_RING_EVENTS
+#define TRACE_RING_EVENTS 16384
+#endif
+
+/*
+ * Read and write events recorded between two clock reads, 1 to stamp every
+ * access with its own clock read.
+ * */
+#ifndef TRACE_CLOCK_EVERY
+#define TRACE_CLOCK_EVERY 16
+#endif
+
+/*
+ * Clock of the events: the time stamp counter where there is one, as it is
+ * several times cheaper to read than steady_clock, else nanoseconds.
+ * */
+inline long int traceClock()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+//steady clock time in nanoseconds
+inline long int traceNow()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+ * Ring buffer of a thread. Only the owning thread writes to it, so recording
+ * an event is a plain store followed by a release store of the head.
+ * */
+class TraceRing
+{
+	//public members of the class
+	public:
+	//number of events ever recorded by the thread
+	std::atomic<unsigned long> head;
+	//index of the thread in the trace
+	short tid;
+	//time of the last clock read and the accesses recorded since
+	long int lastTs;
+	int sinceClock;
+	TraceEvent events[TRACE_RING_EVENTS];
+};
+
+/*
+ * Rings of all the threads that recorded events. Rings are never freed, so
+ * the events of threads that have exited are still written out; the trace
+ * is dumped to $STM_TRACE_FILE, or stm.trace, when the program exits.
+ * */
+class TraceLog
+{
+	//public members of the class
+	public:
+	std::mutex lock;
+	std::vector<TraceRing*> rings;
+	//clock and steady clock when tracing started, to convert ticks to time
+	long int startTicks;
+	long int startNs;
+
+	TraceLog()
+	{
+		startTicks = traceClock();
+		startNs = traceNow();
+	}
+
+	//writes the events of all the rings, oldest first per thread, to 'path'
+	bool dump(const char *path)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		FILE *file = fopen(path, "wb");
+		if(file == NULL) {
+			return false;
+		}
+		TraceHeader header;
+		memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+		header.count = 0;
+		long int ticks = traceClock() - startTicks;
+		header.nsPerTick = (ticks > 0) ? (double)(traceNow() - startNs) / ticks : 1.0;
+		for(size_t i = 0;i<rings.size();i++) {
+			unsigned long head = rings[i]->head.load(std::memory_order_acquire);
+			header.count += (head < TRACE_RING_EVENTS) ? head : TRACE_RING_EVENTS;
+		}
+		fwrite(&header, sizeof(header), 1, file);
+		for(size_t i = 0;i<rings.size();i++) {
+			unsigned long head = rings[i]->head.load(std::memory_order_acquire);
+			unsigned long first = (head < TRACE_RING_EVENTS) ? 0 : head - TRACE_RING_EVENTS;
+			for(unsigned long e = first;e<head;e++) {
+				fwrite(&rings[i]->events[e & (TRACE_RING_EVENTS - 1)], sizeof(TraceEvent), 1, file);
+			}
+		}
+		fclose(file);
+		return true;
+	}
+
+	~TraceLog()
+	{
+		const char *path = getenv("STM_TRACE_FILE");
+		dump(path != NULL ? path : "stm.trace");
+	}
+};
+
+/*
+ * Trace of the process.
+ * */
+inline TraceLog* traceLog()
+{
+	static TraceLog log;
+	return &log;
+}
+
+/*
+ * Ring of the calling thread, registered with the trace on first use.
+ * */
+inline TraceRing* traceRing()
+{
+	static thread_local TraceRing *ring = NULL;
+	if(ring == NULL) {
+		ring = new TraceRing;
+		ring->head.store(0, std::memory_order_relaxed);
+		ring->lastTs = traceClock();
+		ring->sinceClock = 0;
+		TraceLog *log = traceLog();
+		std::lock_guard<std::mutex> guard(log->lock);
+		ring->tid = log->rings.size();
+		log->rings.push_back(ring);
+	}
+	return ring;
+}
+
+/*
+ * Records an event in the ring of the calling thread.
+ * */
+inline void traceEvent(short type, int id, long int its, long int cts, long int wts, long int tltl, long int tutl, long int tobj)
+{
+	TraceRing *ring = traceRing();
+	unsigned long head = ring->head.load(std::memory_order_relaxed);
+	TraceEvent *event = &ring->events[head & (TRACE_RING_EVENTS - 1)];
+	if((type != TRACE_READ && type != TRACE_WRITE) || ++ring->sinceClock >= TRACE_CLOCK_EVERY) {
+		ring->lastTs = traceClock();
+		ring->sinceClock = 0;
+	}
+	event->ts = ring->lastTs;
+	event->its = its;
+	event->cts = cts;
+	event->wts = wts;
+	event->tltl = tltl;
+	event->tutl = tutl;
+	event->tobj = tobj;
+	event->id = id;
+	event->tid = ring->tid;
+	event->type = type;
+	ring->head.store(head + 1, std::memory_order_release);
+}
+
+/*
+ * Writes the trace so far to 'path' without waiting for the program to exit.
+ * */
+inline bool traceDump(const char *path)
+{
+	return traceLog()->dump(path);
+}
+
+#ifdef STM_TRACE_ACCESSES
+#define STM_TRACE_EVENT(type, id, its, cts, wts, tltl, tutl, tobj) traceEvent(type, id, its, cts, wts, tltl, tutl, tobj)
+#else
+//the type is a constant at every call site, so read and write events compile away
+#define STM_TRACE_EVENT(type, id, its, cts, wts, tltl, tutl, tobj) \
+	do { \
+		if((type) != TRACE_READ && (type) != TRACE_WRITE) { \
+			traceEvent(type, id, its, cts, wts, tltl, tutl, tobj); \
+		} \
+	} while(0)
+#endif
+
+#else
+
+//tracing compiled out: the arguments are not even evaluated
+#define STM_TRACE_EVENT(type, id, its, cts, wts, tltl, tutl, tobj)
+
+#endif /* STM_TRACE */
+
+#endif /* TRACE_H */
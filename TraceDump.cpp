@@ -0,0 +1,106 @@
+//
+//  TraceDump.cpp
+//  Converts a trace written by an STM compiled with -DSTM_TRACE to the
+//  Chrome trace_event JSON format, for chrome://tracing or Perfetto.
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+//
+//  Usage: ./TraceDump stm.trace > trace.json
+//
+
+#include "Trace.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+using namespace std;
+
+#define NIL -1
+
+const char *names[] = {"begin", "read", "write", "commit", "abort"};
+
+/*
+ * Prints the timestamps and limits of an event as the args of a JSON event,
+ * leaving out the ones the STM does not have.
+ * */
+void printArgs(TraceEvent *event)
+{
+	printf("\"args\":{\"id\":%d,\"its\":%ld,\"cts\":%ld", event->id, event->its, event->cts);
+	if(event->wts != NIL) {
+		printf(",\"wts\":%ld,\"tltl\":%ld,\"tutl\":%ld", event->wts, event->tltl, event->tutl);
+	}
+	if(event->tobj != NIL) {
+		printf(",\"tobj\":%ld", event->tobj);
+	}
+	printf("}");
+}
+
+/*
+ * Every transaction attempt becomes a complete event from its begin to its
+ * commit or abort, on the thread that began it; reads and writes become
+ * instant events inside it. Times are in microseconds from the first event.
+ * */
+int main(int argc, char *argv[])
+{
+	if(argc != 2) {
+		fprintf(stderr, "usage: %s stm.trace > trace.json\n", argv[0]);
+		return 1;
+	}
+	FILE *file = fopen(argv[1], "rb");
+	if(file == NULL) {
+		perror(argv[1]);
+		return 1;
+	}
+	TraceHeader header;
+	if(fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0) {
+		fprintf(stderr, "%s: not a trace file\n", argv[1]);
+		return 1;
+	}
+	vector<TraceEvent> events(header.count);
+	if(header.count > 0 && fread(&events[0], sizeof(TraceEvent), header.count, file) != (size_t)header.count) {
+		fprintf(stderr, "%s: truncated trace\n", argv[1]);
+		return 1;
+	}
+	fclose(file);
+
+	stable_sort(events.begin(), events.end(), [](const TraceEvent &a, const TraceEvent &b) {
+		return a.ts < b.ts;
+	});
+	long int start = events.empty() ? 0 : events[0].ts;
+	//microseconds per clock tick
+	double usPerTick = header.nsPerTick / 1000.0;
+
+	//begin event of every transaction attempt that has not ended yet
+	map<int, TraceEvent> live;
+	bool first = true;
+	printf("{\"traceEvents\":[\n");
+	for(size_t i = 0;i<events.size();i++) {
+		TraceEvent *event = &events[i];
+		if(event->type == TRACE_BEGIN) {
+			live[event->id] = *event;
+			continue;
+		}
+		fputs(first ? "" : ",\n", stdout);
+		first = false;
+		if(event->type == TRACE_READ || event->type == TRACE_WRITE) {
+			printf("{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,", names[event->type], event->tid, (event->ts - start) * usPerTick);
+			printArgs(event);
+			printf("}");
+			continue;
+		}
+		//commit or abort: close the attempt, which may have begun on another thread
+		map<int, TraceEvent>::iterator begin = live.find(event->id);
+		long int ts = (begin != live.end()) ? begin->second.ts : event->ts;
+		int tid = (begin != live.end()) ? begin->second.tid : event->tid;
+		printf("{\"name\":\"T%d %s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,", event->id, names[event->type], names[event->type], tid, (ts - start) * usPerTick, (event->ts - ts) * usPerTick);
+		printArgs(event);
+		printf("}");
+		if(begin != live.end()) {
+			live.erase(begin);
+		}
+	}
+	printf("\n]}\n");
+	return 0;
+}
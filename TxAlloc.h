@@ -0,0 +1,135 @@
+//  TxAlloc.h
+//  Per thread arena allocator for memory allocated inside transactions
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+
+#ifndef TXALLOC_H
+#define TXALLOC_H
+
+#include <cstdlib>
+#include <cstddef>
+
+/*
+ * Size classes are powers of two from TXALLOC_MIN up to
+ * TXALLOC_MIN << (TXALLOC_CLASSES-1) bytes. Larger blocks are taken from
+ * malloc directly and marked with the TXALLOC_LARGE class.
+ * */
+#define TXALLOC_MIN 16
+#define TXALLOC_CLASSES 9
+#define TXALLOC_LARGE TXALLOC_CLASSES
+#define TXALLOC_CHUNK 65536
+
+/*
+ * Header in front of every block, 16 bytes so that the payload stays
+ * 16 byte aligned.
+ * */
+class TxBlock
+{
+	//public members of the class
+	public:
+	//size class of the block
+	long int sizeClass;
+	//next block in the free list, or in the transaction's allocation chain
+	TxBlock *next;
+};
+
+/*
+ * Arena of a thread: free lists of blocks for every size class, refilled
+ * from TXALLOC_CHUNK sized chunks. Only the owning thread touches it, so
+ * allocation and release take no lock; malloc is only hit for new chunks
+ * and for large blocks. Blocks are never handed back to the heap, a block
+ * released by another thread joins that thread's free list.
+ * */
+class TxArena
+{
+	//public members of the class
+	public:
+	//free blocks of every size class
+	TxBlock *freeList[TXALLOC_CLASSES];
+	//unused tail of the current chunk
+	char *chunk;
+	size_t chunkLeft;
+
+	//constructor: empty arena
+	TxArena()
+	{
+		for(int i = 0;i<TXALLOC_CLASSES;i++) {
+			freeList[i] = NULL;
+		}
+		chunk = NULL;
+		chunkLeft = 0;
+	}
+
+	//returns the payload of a block of at least 'size' bytes, or NULL
+	void* alloc(size_t size)
+	{
+		long int sizeClass = 0;
+		size_t blockSize = TXALLOC_MIN;
+		while(blockSize < size && sizeClass < TXALLOC_CLASSES) {
+			blockSize <<= 1;
+			sizeClass++;
+		}
+
+		TxBlock *block;
+		if(sizeClass == TXALLOC_LARGE) {
+			block = (TxBlock*)malloc(sizeof(TxBlock) + size);
+			if(block == NULL) {
+				return NULL;
+			}
+		} else if(freeList[sizeClass] != NULL) {
+			block = freeList[sizeClass];
+			freeList[sizeClass] = block->next;
+		} else {
+			size_t need = sizeof(TxBlock) + blockSize;
+			//the tail of the old chunk is too small, start a new one
+			if(chunkLeft < need) {
+				chunk = (char*)malloc(TXALLOC_CHUNK);
+				if(chunk == NULL) {
+					chunkLeft = 0;
+					return NULL;
+				}
+				chunkLeft = TXALLOC_CHUNK;
+			}
+			block = (TxBlock*)chunk;
+			chunk += need;
+			chunkLeft -= need;
+		}
+		block->sizeClass = sizeClass;
+		block->next = NULL;
+		return block + 1;
+	}
+
+	//gives a block returned by alloc back to this arena
+	void release(void *ptr)
+	{
+		if(ptr == NULL) {
+			return;
+		}
+		TxBlock *block = (TxBlock*)ptr - 1;
+		if(block->sizeClass == TXALLOC_LARGE) {
+			free(block);
+			return;
+		}
+		block->next = freeList[block->sizeClass];
+		freeList[block->sizeClass] = block;
+	}
+};
+
+/*
+ * Arena of the calling thread.
+ * */
+inline TxArena* txArena()
+{
+	static thread_local TxArena arena;
+	return &arena;
+}
+
+/*
+ * Header of a block returned by TxArena::alloc.
+ * */
+inline TxBlock* txBlock(void *ptr)
+{
+	return (TxBlock*)ptr - 1;
+}
+
+#endif /* TXALLOC_H */
@@ -0,0 +1,93 @@
+//  VLock.h
+//  Versioned lock word shared by KSFTM, PKTO and SFTM
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+
+#ifndef VLOCK_H
+#define VLOCK_H
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+
+/*
+ * Spins before a waiting thread starts yielding the processor.
+ * */
+#define VLOCK_SPINS 64
+
+/*
+ * 64-bit versioned lock word embedded in transaction objects and transactions,
+ * replacing the heap allocated std::mutex. Bit 0 is the lock bit and the
+ * remaining bits count the number of releases, so unlock() both clears the
+ * lock and advances the version.
+ * */
+class VLock
+{
+	//public members of the class
+	public:
+	//lock bit and version of the lock
+	std::atomic<unsigned long> word;
+
+	//constructor: unlocked, version zero
+	VLock()
+	{
+		word.store(0, std::memory_order_relaxed);
+	}
+
+	//copies carry the version but never the lock bit
+	VLock(const VLock &vlock)
+	{
+		word.store(vlock.word.load(std::memory_order_relaxed) & ~1UL, std::memory_order_relaxed);
+	}
+
+	VLock& operator=(const VLock &vlock)
+	{
+		word.store(vlock.word.load(std::memory_order_relaxed) & ~1UL, std::memory_order_relaxed);
+		return *this;
+	}
+
+	//acquire the lock if it is free, without waiting
+	bool try_lock()
+	{
+		unsigned long cur = word.load(std::memory_order_relaxed);
+		if(cur & 1UL) {
+			return false;
+		}
+		return word.compare_exchange_strong(cur, cur | 1UL, std::memory_order_acquire, std::memory_order_relaxed);
+	}
+
+	//acquire the lock: test and test-and-set, yielding once spinning gets long
+	void lock()
+	{
+		int spins = 0;
+		while(!try_lock()) {
+			while(word.load(std::memory_order_relaxed) & 1UL) {
+				if(++spins >= VLOCK_SPINS) {
+					std::this_thread::yield();
+					spins = 0;
+				}
+			}
+		}
+	}
+
+	//release the lock; the lock bit carries into the version count. Only the
+	//holder may call it: on a free word the add would set the lock bit instead
+	void unlock()
+	{
+		assert(word.load(std::memory_order_relaxed) & 1UL);
+		word.fetch_add(1UL, std::memory_order_release);
+	}
+
+	//number of times the lock has been released
+	unsigned long version() const
+	{
+		return word.load(std::memory_order_acquire) >> 1;
+	}
+
+	bool isLocked() const
+	{
+		return (word.load(std::memory_order_relaxed) & 1UL) != 0;
+	}
+};
+
+#endif /* VLOCK_H */
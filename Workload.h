@@ -0,0 +1,259 @@
+//  Workload.h
+//  Workload generator for the test applications of KSFTM, PKTO and SFTM
+//  Created by PDCRL group on 18/10/26.
+//  Copyright © 2026 IIT-HYD. All rights reserved.
+//
+//  Include after the STM, e.g. #include "KSFTM.cpp", as it uses its
+//  LTransaction, TobIdValPair and status macros.
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <vector>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include "Random.h"
+#include "Harness.h"
+
+using namespace std;
+
+/*
+ * Distributions of the transaction objects picked by the operations.
+ * */
+enum KeyDist{KEY_UNIFORM,KEY_ZIPF,KEY_HOTSPOT};
+
+/*
+ * Transaction classes: short transactions mixing reads and writes, long
+ * read-only scans of consecutive objects and blind writes.
+ * */
+enum TxType{TX_SHORT_RW,TX_SCAN,TX_BLIND_WRITE};
+
+/*
+ * Picks transaction object ids in [0, keySpace). Zipfian ids follow the
+ * generator of Gray et al. used by YCSB, id 0 being the most popular; hotspot
+ * ids send hotOpsPer percent of the picks to the first hotKeysPer percent of
+ * the objects.
+ * */
+class KeyChooser
+{
+	//public members of the class
+	public:
+	long int keySpace;
+	KeyDist dist;
+	//zipfian skew, in (0, 1)
+	double theta;
+	//hotspot shape in percent
+	int hotKeysPer;
+	int hotOpsPer;
+
+	KeyChooser(long int keySpace, KeyDist dist, double theta = 0.99, int hotKeysPer = 10, int hotOpsPer = 90)
+	{
+		this->keySpace = keySpace;
+		this->dist = dist;
+		this->theta = theta;
+		this->hotKeysPer = hotKeysPer;
+		this->hotOpsPer = hotOpsPer;
+		if(dist == KEY_ZIPF) {
+			zetan = zeta(keySpace);
+			double zeta2 = zeta(2);
+			alpha = 1.0 / (1.0 - theta);
+			eta = (1.0 - pow(2.0 / keySpace, 1.0 - theta)) / (1.0 - zeta2 / zetan);
+			half = 1.0 + pow(0.5, theta);
+		}
+	}
+
+	long int next(Xoshiro256 &rng)
+	{
+		switch(dist) {
+			case KEY_ZIPF: {
+				double u = rng.uniform();
+				double uz = u * zetan;
+				if(uz < 1.0) {
+					return 0;
+				}
+				if(uz < half) {
+					return 1 % keySpace;
+				}
+				long int key = keySpace * pow(eta * u - eta + 1.0, alpha);
+				return (key < keySpace) ? key : keySpace - 1;
+			}
+			case KEY_HOTSPOT: {
+				long int hotKeys = max(1L, keySpace * hotKeysPer / 100);
+				if(hotKeys == keySpace || rng.below(100) < hotOpsPer) {
+					return rng.below(hotKeys);
+				}
+				return hotKeys + rng.below(keySpace - hotKeys);
+			}
+			default:
+				return rng.below(keySpace);
+		}
+	}
+
+	//private members of the class
+	private:
+	//constants of the zipfian generator
+	double zetan, alpha, eta, half;
+
+	double zeta(long int n)
+	{
+		double sum = 0.0;
+		for(long int i = 1;i<=n;i++) {
+			sum += 1.0 / pow(i, theta);
+		}
+		return sum;
+	}
+};
+
+/*
+ * A transaction class of the mix and its counters.
+ * */
+class TxClass
+{
+	//public members of the class
+	public:
+	TxType type;
+	//relative share of the transactions of this class
+	int weight;
+	//operations per transaction: at most 'ops' for short transactions, exactly 'ops' otherwise
+	int ops;
+	//percentage of reads in a short transaction
+	int readPer;
+	atomic<long int> commits;
+	atomic<long int> aborts;
+
+	TxClass(TxType type, int weight, int ops, int readPer)
+	{
+		this->type = type;
+		this->weight = weight;
+		this->ops = ops;
+		this->readPer = readPer;
+		commits.store(0);
+		aborts.store(0);
+	}
+};
+
+/*
+ * Mix of transaction classes run on an STM of type 'STMType' (KSFTM, PKTO or
+ * SFTM). Thread 'threadId' calls run(threadId), which picks a class by
+ * weight, executes a transaction of it until it commits and returns the
+ * number of aborts. Every thread draws from its own generator, seeded from
+ * 'seed' and its id, so a thread issues the same transactions in every run
+ * with the same seed.
+ * */
+template<class STMType>
+class Workload
+{
+	//public members of the class
+	public:
+	KeyChooser keys;
+	vector<TxClass*> classes;
+
+	Workload(STMType *lib, long int keySpace, KeyDist dist, int numThreads, unsigned long seed, double theta = 0.99, int hotKeysPer = 10, int hotOpsPer = 90)
+		: keys(keySpace, dist, theta, hotKeysPer, hotOpsPer)
+	{
+		this->lib = lib;
+		totalWeight = 0;
+		for(int i = 0;i<numThreads;i++) {
+			rngs.push_back(Xoshiro256(seed * numThreads + i));
+		}
+	}
+
+	//adds a class to the mix, classes of weight zero are left out
+	void addClass(TxType type, int weight, int ops, int readPer)
+	{
+		if(weight <= 0) {
+			return;
+		}
+		classes.push_back(new TxClass(type, weight, ops, readPer));
+		totalWeight += weight;
+	}
+
+	/*
+	 * Runs one transaction of a class drawn at random to commit on thread
+	 * 'threadId' and returns the number of times it aborted. The class
+	 * counters count it only if 'harness' is measuring when it commits, as
+	 * the harness does, or always when there is no harness.
+	 * */
+	int run(int threadId, const Harness *harness = NULL)
+	{
+		Xoshiro256 &rng = rngs[threadId];
+		int pick = rng.below(totalWeight);
+		TxClass *txClass = classes[0];
+		for(int i = 0;i<classes.size();i++) {
+			if(pick < classes[i]->weight) {
+				txClass = classes[i];
+				break;
+			}
+			pick -= classes[i]->weight;
+		}
+
+		/*The operations are drawn once, so that a retried transaction
+		  repeats the same accesses and retries do not shift the generator*/
+		int numOps = (txClass->type == TX_SHORT_RW) ? 1 + rng.below(txClass->ops) : txClass->ops;
+		vector<long int> tobjIds(numOps);
+		vector<bool> isRead(numOps);
+		vector<long int> vals(numOps);
+		long int first = keys.next(rng);
+		for(int i = 0;i<numOps;i++) {
+			switch(txClass->type) {
+				case TX_SCAN:
+					tobjIds[i] = (first + i) % keys.keySpace;
+					isRead[i] = true;
+					break;
+				case TX_BLIND_WRITE:
+					tobjIds[i] = keys.next(rng);
+					isRead[i] = false;
+					break;
+				default:
+					tobjIds[i] = keys.next(rng);
+					isRead[i] = rng.below(100) < txClass->readPer;
+			}
+			vals[i] = isRead[i] ? 0 : rng.below(1000);
+		}
+
+		int localAbortCnt = 0;
+		LTransaction *T = lib->tbegin(NIL);
+		while(true) {
+			bool aborted = false;
+			for(int i = 0;i<numOps && !aborted;i++) {
+				TobIdValPair tobj_id_val_pair;
+				tobj_id_val_pair.id = tobjIds[i];
+				if(isRead[i]) {
+					aborted = (lib->stmRead(T, &tobj_id_val_pair) == ABORTED);
+				} else {
+					tobj_id_val_pair.val = vals[i];
+					lib->stmWrite(T, &tobj_id_val_pair);
+				}
+			}
+			if(!aborted && lib->stmTryCommit(T) == OK) {
+				break;
+			}
+			localAbortCnt++;
+			T = lib->tbegin(T->g_its);
+		}
+		if(harness == NULL || harness->measuring()) {
+			txClass->commits.fetch_add(1);
+			txClass->aborts.fetch_add(localAbortCnt);
+		}
+		return localAbortCnt;
+	}
+
+	//prints the commits and aborts of every class
+	void report()
+	{
+		const char *names[] = {"short rw", "scan", "blind write"};
+		for(int i = 0;i<classes.size();i++) {
+			cout<<names[classes[i]->type]<<"\tcommits "<<classes[i]->commits.load()<<"\taborts "<<classes[i]->aborts.load()<<endl;
+		}
+	}
+
+	//private members of the class
+	private:
+	STMType *lib;
+	int totalWeight;
+	//generator of every thread
+	vector<Xoshiro256> rngs;
+};
+
+#endif /* WORKLOAD_H */